@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+// Chunked bodies split at every byte: the body is cut into chunks of every
+// size, and the connection hands it over in reads of every size from 1 to
+// MAX_READ bytes. Both the plain read path and the query path must decode it,
+// and must stop at the end of the response on a kept-alive connection. The
+// query results hold fields nested deeper than PARSE_JSON_MAX_DEPTH, which are
+// dropped without losing the results.
+
+#include <Parse.h>
+#include "stub/MockClient.h"
+
+static const size_t MAX_READ = 64;
+
+static std::string chunked(const std::string& body, size_t chunkSize) {
+  std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+  for (size_t i = 0; i < body.size(); i += chunkSize) {
+    std::string chunk = body.substr(i, chunkSize);
+    char size[32];
+    // Every other chunk size is in upper case and has an extension.
+    snprintf(size, sizeof(size), (i / chunkSize) % 2 ? "%zX;ext=1" : "%zx", chunk.size());
+    response += std::string(size) + "\r\n" + chunk + "\r\n";
+  }
+  return response + "0\r\nX-Trailer: yes\r\n\r\n";
+}
+
+int main() {
+  Parse.begin("app", "key");
+#ifdef ARDUINO_ARCH_ESP8266
+  Parse.setServerURL("host");
+#endif
+  Parse.setKeepAlive(true);
+
+  std::string deep = std::string(20, '[') + "1,\"]\"" + std::string(20, ']');
+  std::string results = "{\"results\":[{\"objectId\":\"a\",\"d\":" + deep + ",\"t\":1},"
+                        "{\"objectId\":\"b\",\"s\":\"}]\\\"\",\"t\":2,\"d\":" + deep + "}]}";
+  std::string object = "{\"objectId\":\"xyz\",\"n\":42}";
+  std::string next = "HTTP/1.1 200 OK\r\nContent-Length: 8\r\n\r\n{\"a\":14}";
+
+  int runs = 0;
+  int failures = 0;
+  for (size_t chunkSize = 1; chunkSize <= results.size(); ++chunkSize) {
+    for (size_t readSize = 1; readSize <= MAX_READ; ++readSize) {
+      MockClient::serve(chunked(results, chunkSize) + chunked(object, chunkSize) + next, readSize);
+      int connects = MockClient::connects;
+
+      // Query path
+      std::string ids;
+      {
+        ParseQuery query;
+        query.setClassName("T");
+        ParseResponse response = query.send();
+        response.count();
+        while (response.nextObject()) {
+          ids += response.getString("objectId");
+          ids += std::to_string(response.getInt("t"));
+          ids += response.isTruncated() ? "!" : "";
+        }
+      }
+      // Plain read path
+      std::string fields;
+      {
+        ParseResponse response = Parse.sendRequest("GET", "/1/classes/T/xyz", "", "");
+        fields = std::string(response.getString("objectId")) + std::to_string(response.getInt("n"));
+      }
+      // The connection is still in step with the server.
+      int a;
+      {
+        ParseResponse response = Parse.sendRequest("GET", "/1/classes/T/a", "", "");
+        a = response.getInt("a");
+      }
+
+      ++runs;
+      bool ok = ids == "a1!b2!" && fields == "xyz42" && a == 14 &&
+                MockClient::remaining() == 0 && MockClient::connects - connects <= 1;
+      if (!ok && failures++ < 10) {
+        printf("FAIL chunk=%zu read=%zu: query=%s object=%s next=%d\n",
+               chunkSize, readSize, ids.c_str(), fields.c_str(), a);
+      }
+    }
+  }
+  printf("chunked_test: %d runs, %d failures\n", runs, failures);
+  return failures ? 1 : 0;
+}
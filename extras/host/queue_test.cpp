@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+// The offline queue survives a reboot: requests queued on one boot are loaded
+// from flash by begin() on the next and replayed in order, and once they have
+// been sent they stay sent. The test restarts itself for each boot, with the
+// flash kept in a file next to the executable.
+
+#include <Parse.h>
+#include <unistd.h>
+#include "stub/MockClient.h"
+
+static int failures = 0;
+
+static void check(bool ok, int boot, const char* what) {
+  if (!ok) {
+    printf("FAIL boot %d: %s\n", boot, what);
+    ++failures;
+  }
+}
+
+int main(int argc, char** argv) {
+#ifdef ARDUINO_SAMD_ZERO
+  int boot = argc > 1 ? atoi(argv[1]) : 1;
+  failures = argc > 2 ? atoi(argv[2]) : 0;
+  std::string flashFile = std::string(argv[0]) + ".flash";
+  if (boot == 1) {
+    remove(flashFile.c_str());
+    setenv("FLASH_FILE", flashFile.c_str(), 1);
+  }
+
+  Parse.begin("app", "key");
+  Parse.setOfflineQueue(true);
+  ParseOfflineQueue queue;
+  queue.begin();
+
+  if (boot == 1) {
+    check(queue.size() == 0, boot, "queue not empty on first boot");
+    ParseObjectCreate create;
+    create.setClassName("T");
+    create.add("t", 1);
+    create.sendLater();
+    ParseTrackEvent event;
+    event.setEventName("boot");
+    event.sendLater();
+    ParseObjectUpdate update;
+    update.setClassName("T");
+    update.setObjectId("x");
+    update.add("t", 2);
+    update.sendLater();
+    check(Parse.getOfflineQueueSize() == 3, boot, "requests not queued");
+  } else if (boot == 2) {
+    check(queue.size() == 3, boot, "queue not loaded from flash");
+    std::string results = "[{\"success\":{}},{\"success\":{}},{\"success\":{}}]";
+    MockClient::serve("HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(results.size()) +
+                      "\r\n\r\n" + results, 1 << 30);
+    check(Parse.sendOfflineQueue(), boot, "queue not sent");
+    size_t body = MockClient::outgoing.find("\r\n\r\n");
+    std::string requests = body == std::string::npos ? "" : MockClient::outgoing.substr(body + 4);
+    check(requests == "{\"requests\":["
+                      "{\"method\":\"POST\",\"path\":\"/classes/T\",\"body\":{\"t\":1}},"
+                      "{\"method\":\"POST\",\"path\":\"/events/boot\",\"body\":{}},"
+                      "{\"method\":\"PUT\",\"path\":\"/classes/T/x\",\"body\":{\"t\":2}}]}",
+          boot, "requests not replayed in order");
+    check(Parse.getOfflineQueueSize() == 0, boot, "queue not empty after sending");
+  } else {
+    check(queue.size() == 0, boot, "sent requests came back");
+    remove(flashFile.c_str());
+    printf("queue_test: %d boots, %d failures\n", boot, failures);
+    return failures ? 1 : 0;
+  }
+
+  // Reboot.
+  fflush(stdout);
+  std::string nextBoot = std::to_string(boot + 1);
+  std::string failed = std::to_string(failures);
+  execl(argv[0], argv[0], nextBoot.c_str(), failed.c_str(), (char*)NULL);
+  printf("FAIL boot %d: cannot restart\n", boot);
+  return 1;
+#else
+  printf("queue_test: no offline queue on this board\n");
+  return 0;
+#endif
+}
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+// Throughput of reading a 16 KB query response. The connection delivers it
+// one TCP segment per read, and then one byte per read.
+//
+// The first rows compare the input layers alone. "byte loop" is the loop of
+// ParseResponse::read() before ParseResponseReader: one client read() per
+// byte, and a delay(1) each time the client runs dry, until the connection
+// closes. "reader loop" is the same loop on top of ParseResponseReader. The
+// other rows go through the library, with nextObject() and getJSONBody().
+//
+// MB/s is measured on the host, where a read is a memcpy and delay() returns
+// at once. "model MB/s" is not measured: it adds READ_COST per read and 1 ms
+// per delay(1) to the host time. READ_COST is a rough figure for one
+// WiFiClientSecure::read() on an ESP8266.
+
+#include <Parse.h>
+#include <chrono>
+#include "ParseResponseReader.h"
+#include "stub/MockClient.h"
+
+static const size_t BODY_SIZE = 16 * 1024;
+static const size_t SEGMENT = 1460;
+static const int ROUNDS = 500;
+static const double READ_COST = 5e-6; // seconds
+
+static std::string queryResponse() {
+  std::string body = "{\"results\":[";
+  for (int i = 0; body.size() < BODY_SIZE - 100; ++i) {
+    if (i)
+      body += ",";
+    body += "{\"objectId\":\"obj" + std::to_string(i) + "\",\"temperature\":" +
+            std::to_string(20 + i % 10) + ".5,\"createdAt\":\"2015-09-01T12:00:00.000Z\"}";
+  }
+  body += "]}";
+  return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+// The header filter and body copy of the old ParseResponse::read().
+struct BodyCopy {
+  char body[BODY_SIZE + 1];
+  int length;
+  int newlines;
+  bool data;
+
+  BodyCopy() : length(0), newlines(0), data(false) {}
+
+  void add(char c) {
+    if (c == '\r')
+      return;
+    if (data && length < (int)BODY_SIZE)
+      body[length++] = c;
+    if (c == '\n')
+      newlines++;
+    else
+      newlines = 0;
+    if (newlines >= 2)
+      data = true;
+  }
+};
+
+static int byteLoop() {
+  ConnectionClient client;
+  BodyCopy copy;
+  while (client.connected()) {
+    delay(1);
+    while (client.available())
+      copy.add(client.read());
+  }
+  return copy.length;
+}
+
+static int readerLoop() {
+  ConnectionClient client;
+  ParseResponseReader reader(client);
+  BodyCopy copy;
+  while (client.connected() || reader.available()) {
+    int c = reader.read();
+    if (c < 0)
+      delay(1);
+    else
+      copy.add(c);
+  }
+  return copy.length;
+}
+
+enum Path { BYTE_LOOP, READER_LOOP, NEXT_OBJECT, GET_JSON_BODY };
+
+static void run(const char* name, const std::string& response, size_t readSize, Path path) {
+  long bytes = 0;
+  int objects = 0;
+  std::chrono::steady_clock::time_point start;
+  // The first round warms up the buffer pool and is not counted.
+  for (int round = -1; round < ROUNDS; ++round) {
+    if (round == 0) {
+      bytes = 0;
+      objects = 0;
+      MockClient::reads = 0;
+      hostDelayed = 0;
+      start = std::chrono::steady_clock::now();
+    }
+    MockClient::serve(response, readSize);
+    if (path == BYTE_LOOP || path == READER_LOOP) {
+      // The server closes the connection after the response.
+      MockClient::open = false;
+      if ((path == BYTE_LOOP ? byteLoop() : readerLoop()) != (int)response.size() - (int)response.find("{"))
+        printf("%s: body cut short\n", name);
+    } else {
+      ParseQuery q;
+      q.setClassName("Temperature");
+      ParseResponse r = q.send();
+      if (path == NEXT_OBJECT) {
+        r.count();
+        while (r.nextObject())
+          objects++;
+      } else {
+        r.getJSONBody();
+      }
+    }
+    bytes += MockClient::position;
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double model = seconds + MockClient::reads * READ_COST + hostDelayed / 1000.0;
+  printf("%-28s %7s %7ld %7ld %9.2f %10.3f\n", name,
+         path == NEXT_OBJECT ? std::to_string(objects / ROUNDS).c_str() : "-",
+         MockClient::reads / ROUNDS, (long)(hostDelayed / ROUNDS), bytes / seconds / 1e6, bytes / model / 1e6);
+}
+
+int main() {
+  Parse.begin("app", "key");
+#ifdef ARDUINO_ARCH_ESP8266
+  Parse.setServerURL("host");
+#endif
+  std::string response = queryResponse();
+  printf("%zu byte response, %d rounds, model: %g s per read, 1 ms per delay(1)\n",
+         response.size(), ROUNDS, READ_COST);
+  printf("%-28s %7s %7s %7s %9s %10s\n", "", "objects", "reads", "delays", "MB/s", "model MB/s");
+  run("byte loop, segments", response, SEGMENT, BYTE_LOOP);
+  run("reader loop, segments", response, SEGMENT, READER_LOOP);
+  run("nextObject(), segments", response, SEGMENT, NEXT_OBJECT);
+  run("nextObject(), single bytes", response, 1, NEXT_OBJECT);
+  run("getJSONBody(), segments", response, SEGMENT, GET_JSON_BODY);
+  run("getJSONBody(), single bytes", response, 1, GET_JSON_BODY);
+  return 0;
+}
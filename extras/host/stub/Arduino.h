@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef Arduino_h
+#define Arduino_h
+
+// Just enough of the Arduino core to build the library on a desktop host.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <strings.h>
+#include <string>
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+extern unsigned long hostDelayed; // ms passed to delay(), which returns at once
+inline void yield() {}
+
+class String {
+public:
+  String() {}
+  String(const char* c) : s(c ? c : "") {}
+  String(const String& other) : s(other.s) {}
+  explicit String(int v) : s(std::to_string(v)) {}
+  explicit String(long v) : s(std::to_string(v)) {}
+  explicit String(unsigned long v) : s(std::to_string(v)) {}
+  explicit String(double v) { char b[32]; snprintf(b, sizeof(b), "%.2f", v); s = b; }
+
+  String& operator=(const String& other) { s = other.s; return *this; }
+  String& operator=(const char* c) { s = c ? c : ""; return *this; }
+  String& operator+=(const String& other) { s += other.s; return *this; }
+  String& operator+=(const char* c) { s += c; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  String& operator+=(int v) { s += std::to_string(v); return *this; }
+  String& operator+=(unsigned v) { s += std::to_string(v); return *this; }
+  String& operator+=(long v) { s += std::to_string(v); return *this; }
+  String& operator+=(double v) { char b[32]; snprintf(b, sizeof(b), "%.2f", v); s += b; return *this; }
+  bool operator==(const char* c) const { return s == c; }
+  bool operator!=(const char* c) const { return s != c; }
+  bool operator==(const String& other) const { return s == other.s; }
+  bool operator!=(const String& other) const { return s != other.s; }
+  char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  char operator[](int i) const { return (size_t)i < s.size() ? s[i] : 0; }
+
+  const char* c_str() const { return s.c_str(); }
+  unsigned int length() const { return s.size(); }
+  bool equals(const char* c) const { return s == c; }
+  bool startsWith(const char* c) const { return s.compare(0, strlen(c), c) == 0; }
+  int indexOf(const char* c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+  long toInt() const { return atol(s.c_str()); }
+  unsigned char reserve(unsigned int size) { s.reserve(size); return 1; }
+  unsigned char concat(const char* c, unsigned int n) { s.append(c, n); return 1; }
+
+private:
+  std::string s;
+};
+
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+
+class Print;
+
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t n) { size_t k = 0; while (n--) k += write(*data++); return k; }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* data, size_t n) { return write((const uint8_t*)data, n); }
+  virtual int availableForWrite() { return 0; }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { char b[16]; snprintf(b, sizeof(b), "%d", v); return write(b); }
+  size_t print(unsigned v) { char b[16]; snprintf(b, sizeof(b), "%u", v); return write(b); }
+  size_t print(long v) { char b[24]; snprintf(b, sizeof(b), "%ld", v); return write(b); }
+  size_t print(unsigned long v) { char b[24]; snprintf(b, sizeof(b), "%lu", v); return write(b); }
+  size_t print(double v, int digits = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, v); return write(b); }
+  size_t print(const Printable& p) { return p.printTo(*this); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+};
+
+class Client : public Stream {
+public:
+  virtual int read(uint8_t* buf, size_t size) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void stop() = 0;
+  using Stream::read;
+  using Print::write;
+};
+
+// Output is dropped, and the library's debug output is off.
+class HardwareSerial : public Stream {
+public:
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  operator bool() { return false; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // Arduino_h
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef MockClient_h
+#define MockClient_h
+
+#include <Arduino.h>
+
+// A connection to a scripted server. Whatever the library writes goes to
+// outgoing; reads return incoming, at most readSize bytes per read() and
+// available(), so a test can split a response at any byte.
+// The state is static because the library owns its client objects.
+class MockClient : public Client {
+public:
+  static std::string incoming;
+  static size_t position;
+  static size_t readSize;
+  static std::string outgoing;
+  static bool open;
+  static int connects;
+  static long reads; // calls to read(), for benchmarks
+
+  // Serve response to the next requests, readSize bytes at a time.
+  static void serve(const std::string& response, size_t readSize) {
+    incoming = response;
+    position = 0;
+    MockClient::readSize = readSize;
+    outgoing.clear();
+  }
+
+  static size_t remaining() {
+    return incoming.size() - position;
+  }
+
+  int connect(const char*, uint16_t) { open = true; connects++; return 1; }
+  int connectSSL(const char* host, uint16_t port) { return connect(host, port); }
+  uint8_t connected() override { return open || remaining() > 0; }
+  void stop() override { open = false; }
+  operator bool() { return open; }
+
+  int available() override {
+    return remaining() < readSize ? remaining() : readSize;
+  }
+
+  int read() override {
+    reads++;
+    return remaining() ? (uint8_t)incoming[position++] : -1;
+  }
+
+  int read(uint8_t* buf, size_t size) override {
+    reads++;
+    size_t n = available();
+    if (n > size)
+      n = size;
+    memcpy(buf, incoming.data() + position, n);
+    position += n;
+    return n;
+  }
+
+  int peek() override {
+    return remaining() ? (uint8_t)incoming[position] : -1;
+  }
+
+  size_t write(uint8_t c) override { outgoing += (char)c; return 1; }
+  size_t write(const uint8_t* data, size_t n) override { outgoing.append((const char*)data, n); return n; }
+  using Print::write;
+
+  bool setFingerprint(const char*) { return true; }
+  void setInsecure() {}
+  void setTimeout(unsigned long) {}
+};
+
+#endif // MockClient_h
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <chrono>
+#include "MockClient.h"
+
+HardwareSerial Serial;
+
+std::string MockClient::incoming;
+size_t MockClient::position = 0;
+size_t MockClient::readSize = 1 << 30;
+std::string MockClient::outgoing;
+bool MockClient::open = false;
+int MockClient::connects = 0;
+long MockClient::reads = 0;
+
+static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long hostDelayed = 0;
+
+void delay(unsigned long ms) {
+  hostDelayed += ms;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  return write(buf);
+}
+
+#ifdef ARDUINO_SAMD_ZERO
+#include <sys/mman.h>
+#include <unistd.h>
+#include <map>
+#include <external/FlashStorage/FlashStorage.h>
+
+// Flash is ordinary memory here. The storage is declared const and lands in
+// read-only pages, which are made writable on first use.
+static void unprotect(const volatile void* address, uint32_t size) {
+  uintptr_t page = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = (uintptr_t)address & ~(page - 1);
+  uintptr_t end = ((uintptr_t)address + size + page - 1) & ~(page - 1);
+  mprotect((void*)begin, end - begin, PROT_READ | PROT_WRITE);
+}
+
+// When FLASH_FILE is set, every region is also kept in that file, one after
+// the other, so that a test can restart the program and find the flash as it
+// left it. A region is loaded on first use: the regions are constructed
+// before main() has a chance to set FLASH_FILE.
+struct FlashRegion {
+  long offset;
+  bool loaded;
+};
+
+static std::map<const FlashClass*, FlashRegion>& flashRegions() {
+  static std::map<const FlashClass*, FlashRegion> regions;
+  return regions;
+}
+
+static long flashFileSize = 0;
+
+static FlashRegion& flashRegion(const FlashClass* flash, const volatile void* address, uint32_t size) {
+  FlashRegion& region = flashRegions()[flash];
+  const char* path = getenv("FLASH_FILE");
+  if (!region.loaded && path) {
+    unprotect(address, size);
+    FILE* file = fopen(path, "rb");
+    if (file) {
+      if (fseek(file, region.offset, SEEK_SET) == 0)
+        fread((void*)address, 1, size, file);
+      fclose(file);
+    }
+  }
+  region.loaded = true;
+  return region;
+}
+
+static void saveFlash(const FlashRegion& region, const volatile void* address, uint32_t size) {
+  const char* path = getenv("FLASH_FILE");
+  if (!path)
+    return;
+  FILE* file = fopen(path, "r+b");
+  if (!file)
+    file = fopen(path, "w+b");
+  if (!file)
+    return;
+  fseek(file, region.offset, SEEK_SET);
+  fwrite((const void*)address, 1, size, file);
+  fclose(file);
+}
+
+FlashClass::FlashClass(const void* flash_addr, uint32_t size) :
+  PAGE_SIZE(64), PAGES(4096), MAX_FLASH(PAGE_SIZE * PAGES), ROW_SIZE(PAGE_SIZE * 4),
+  flash_address((volatile void*)flash_addr), flash_size(size) {
+  FlashRegion region = { flashFileSize, false };
+  flashRegions()[this] = region;
+  flashFileSize += size;
+}
+
+void FlashClass::write(const volatile void* flash_ptr, const void* data, uint32_t size) {
+  FlashRegion& region = flashRegion(this, flash_address, flash_size);
+  // Like real flash, a write can only clear bits.
+  unprotect(flash_ptr, size);
+  for (uint32_t i = 0; i < size; ++i)
+    ((uint8_t*)flash_ptr)[i] &= ((const uint8_t*)data)[i];
+  saveFlash(region, flash_address, flash_size);
+}
+
+void FlashClass::erase(const volatile void* flash_ptr, uint32_t size) {
+  FlashRegion& region = flashRegion(this, flash_address, flash_size);
+  unprotect(flash_ptr, size);
+  memset((void*)flash_ptr, 0xFF, size);
+  saveFlash(region, flash_address, flash_size);
+}
+
+void FlashClass::read(const volatile void* flash_ptr, void* data, uint32_t size) {
+  flashRegion(this, flash_address, flash_size);
+  memcpy(data, (const void*)flash_ptr, size);
+}
+#endif
@@ -43,6 +43,7 @@
 #include <internal/ParseObjectDelete.h>
 #include <internal/ParseObjectGet.h>
 #include <internal/ParseObjectUpdate.h>
+#include <internal/ParseBatch.h>
 #include <internal/ParseCloudFunction.h>
 #include <internal/ParseTrackEvent.h>
 
@@ -46,6 +46,9 @@ public:
   void erase(const volatile void *flash_ptr, uint32_t size);
   void read(const volatile void *flash_ptr, void *data, uint32_t size);
 
+  // A single write() must not cross a page boundary.
+  uint32_t pageSize() const { return PAGE_SIZE; }
+
 private:
   void erase(const volatile void *flash_ptr);
 
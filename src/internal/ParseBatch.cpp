@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseInternal.h"
+#include "ParseClient.h"
+#include "ParseBatch.h"
+
+ParseBatch::ParseBatch() {
+	clear();
+}
+
+void ParseBatch::addRequest(const String& method, const String& path, const String& body) {
+	requestBody += (requestCount ? ",{\"method\":\"" : "{\"method\":\"");
+	requestBody += method;
+	requestBody += "\",\"path\":\"";
+	requestBody += path;
+	requestBody += "\"";
+	if (body.length()) {
+		requestBody += ",\"body\":";
+		requestBody += body;
+	}
+	requestBody += "}";
+	++requestCount;
+}
+
+void ParseBatch::addRequest(const char* method, ParseRequest& request, bool hasBody) {
+	if (!hasBody) {
+		addRequest(method, request.httpPath, "");
+	} else if (request.isBodySet) {
+		addRequest(method, request.httpPath, request.requestBody);
+	} else {
+		addRequest(method, request.httpPath, request.requestBody + "}");
+	}
+}
+
+bool ParseBatch::add(ParseObjectCreate& create) {
+	if (requestCount >= MAX_REQUESTS) {
+		return false;
+	}
+	addRequest("POST", create, true);
+	return true;
+}
+
+bool ParseBatch::add(ParseObjectUpdate& update) {
+	if (requestCount >= MAX_REQUESTS) {
+		return false;
+	}
+	addRequest("PUT", update, true);
+	return true;
+}
+
+bool ParseBatch::add(ParseObjectDelete& remove) {
+	if (requestCount >= MAX_REQUESTS) {
+		return false;
+	}
+	addRequest("DELETE", remove, false);
+	return true;
+}
+
+int ParseBatch::size() {
+	return requestCount;
+}
+
+void ParseBatch::clear() {
+	requestBody = "{\"requests\":[";
+	requestCount = 0;
+}
+
+ParseResponse ParseBatch::send() {
+	String body = requestBody;
+	body += "]}";
+	ParseResponse response = Parse.sendRequest("POST", "/batch", body, "");
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+	response.isBatch = true;
+#endif
+	return response;
+}
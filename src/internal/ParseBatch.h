@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseBatch_h
+#define ParseBatch_h
+
+#include "ParseObjectCreate.h"
+#include "ParseObjectUpdate.h"
+#include "ParseObjectDelete.h"
+
+/*! \file ParseBatch.h
+ *  \brief ParseBatch object for the Yun
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseBatch
+ *  \brief Class responsible for sending several object requests at once.
+ *
+ *  Creates, updates and deletes that are added to the batch are sent to the
+ *  server in one request instead of one request each.
+ */
+class ParseBatch {
+	friend class ParseClient;
+private:
+	String requestBody;
+	int requestCount;
+	void addRequest(const String& method, const String& path, const String& body);
+	void addRequest(const char* method, ParseRequest& request, bool hasBody);
+public:
+  /*! \var MAX_REQUESTS
+   *  \brief the most requests the server accepts in one batch.
+   */
+  const static int MAX_REQUESTS = 50;
+
+  /*! \fn ParseBatch()
+   *  \brief Constructor of ParseBatch object
+   */
+  ParseBatch();
+
+  /*! \fn bool add(ParseObjectCreate& create)
+   *  \brief add an object creation to the batch.
+   *
+   *  \param create - the creation request, set up as for send().
+   *  \result false if the batch is already full
+   */
+  bool add(ParseObjectCreate& create);
+
+  /*! \fn bool add(ParseObjectUpdate& update)
+   *  \brief add an object update to the batch.
+   *
+   *  \param update - the update request, set up as for send().
+   *  \result false if the batch is already full
+   */
+  bool add(ParseObjectUpdate& update);
+
+  /*! \fn bool add(ParseObjectDelete& remove)
+   *  \brief add an object deletion to the batch.
+   *
+   *  \param remove - the deletion request, set up as for send().
+   *  \result false if the batch is already full
+   */
+  bool add(ParseObjectDelete& remove);
+
+  /*! \fn int size()
+   *  \brief number of requests in the batch.
+   */
+  int size();
+
+  /*! \fn void clear()
+   *  \brief remove all requests from the batch.
+   */
+  void clear();
+
+  /*! \fn ParseResponse send()
+   *  \brief send all requests of the batch in one request.
+   *
+   *  The response holds one result per request, in the order they were added.
+   *  Iterate them with nextObject(): getErrorCode() is 0 for a request that
+   *  succeeded, and the getters return its result, e.g. getString("objectId").
+   *  \code
+   *  ParseResponse response = batch.send();
+   *  while (response.nextObject()) {
+   *    if (response.getErrorCode()) {
+   *      // handle failed request
+   *    }
+   *  }
+   *  response.close();
+   *  \endcode
+   *
+   *  \result response of request
+   */
+  ParseResponse send();
+};
+
+#endif
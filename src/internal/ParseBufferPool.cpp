@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+
+#include "ParseBufferPool.h"
+
+ParseBufferPool::ParseBufferPool() {
+  for (int i = 0; i < MAX_BLOCKS; ++i) {
+#ifdef PARSE_STATIC_BUFFERS
+    blocks[i] = storage[i];
+#else
+    blocks[i] = NULL;
+#endif
+    inUse[i] = false;
+  }
+  for (int i = 0; i < MAX_ENDPOINTS; ++i) {
+    sizes[i].endpoint = 0;
+    sizes[i].size = 0;
+  }
+}
+
+char* ParseBufferPool::take() {
+  for (int i = 0; i < MAX_BLOCKS; ++i) {
+    if (blocks[i] && !inUse[i]) {
+      inUse[i] = true;
+      return blocks[i];
+    }
+  }
+#ifdef PARSE_STATIC_BUFFERS
+  return NULL;
+#else
+  for (int i = 0; i < MAX_BLOCKS; ++i) {
+    if (!blocks[i]) {
+      blocks[i] = new char[BLOCK_SIZE];
+      inUse[i] = true;
+      return blocks[i];
+    }
+  }
+  // Every kept buffer is lent out, this one is freed when it comes back.
+  return new char[BLOCK_SIZE];
+#endif
+}
+
+void ParseBufferPool::give(char* block) {
+  for (int i = 0; i < MAX_BLOCKS; ++i) {
+    if (blocks[i] == block) {
+      inUse[i] = false;
+      return;
+    }
+  }
+#ifndef PARSE_STATIC_BUFFERS
+  delete[] block;
+#endif
+}
+
+unsigned long ParseBufferPool::endpointHash(const char* httpVerb, const char* httpPath) {
+  unsigned long hash = 5381;
+  for (; *httpVerb; ++httpVerb)
+    hash = hash * 33 + *httpVerb;
+  for (; *httpPath && *httpPath != '?'; ++httpPath)
+    hash = hash * 33 + *httpPath;
+  return hash ? hash : 1;
+}
+
+int ParseBufferPool::sizeFor(unsigned long endpoint) {
+  for (int i = 0; i < MAX_ENDPOINTS; ++i) {
+    if (endpoint && sizes[i].endpoint == endpoint)
+      return moveToFront(i).size;
+  }
+  return 0;
+}
+
+void ParseBufferPool::recordSize(unsigned long endpoint, int size) {
+  // Keep the largest size of each endpoint. The table is kept in order of
+  // use, so when it is full the endpoint used least recently makes room.
+  int i = 0;
+  while (i < MAX_ENDPOINTS - 1 && sizes[i].endpoint != endpoint)
+    ++i;
+  EndpointSize& entry = moveToFront(i);
+  if (entry.endpoint != endpoint) {
+    entry.endpoint = endpoint;
+    entry.size = 0;
+  }
+  if (size > entry.size)
+    entry.size = size;
+}
+
+ParseBufferPool::EndpointSize& ParseBufferPool::moveToFront(int i) {
+  EndpointSize entry = sizes[i];
+  for (; i > 0; --i)
+    sizes[i] = sizes[i - 1];
+  sizes[0] = entry;
+  return sizes[0];
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseBufferPool_h
+#define ParseBufferPool_h
+
+#include <Arduino.h>
+#include "ParseConfig.h"
+
+/*! \file ParseBufferPool.h
+ *  \brief ParseBufferPool object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseBufferPool
+ *  \brief Lends fixed-size buffers to responses and takes them back.
+ *
+ *  A buffer is allocated the first time it is needed and kept afterwards, so
+ *  that a device sending requests for days does not fragment its heap with
+ *  buffers of changing sizes. Should more responses be open at once than
+ *  there are buffers, the extra ones are allocated and freed as before,
+ *  unless PARSE_STATIC_BUFFERS is defined, see ParseConfig.h.
+ *
+ *  The pool also remembers how large a buffer the responses of the
+ *  MAX_ENDPOINTS most recently used endpoints had to grow to, so that the
+ *  next response of the same endpoint can start at that size.
+ */
+class ParseBufferPool {
+public:
+  /*! \var BLOCK_SIZE
+   *  \brief size of each buffer.
+   */
+  const static int BLOCK_SIZE = PARSE_RESPONSE_BUFFER_SIZE;
+
+  /*! \var MAX_BLOCKS
+   *  \brief number of buffers kept for reuse.
+   */
+  const static int MAX_BLOCKS = PARSE_RESPONSE_BUFFERS;
+
+  /*! \var MAX_ENDPOINTS
+   *  \brief number of endpoints whose response size is remembered.
+   */
+  const static int MAX_ENDPOINTS = 8;
+
+private:
+  struct EndpointSize {
+    unsigned long endpoint;
+    int size;
+  };
+
+  char* blocks[MAX_BLOCKS];
+  bool inUse[MAX_BLOCKS];
+#ifdef PARSE_STATIC_BUFFERS
+  char storage[MAX_BLOCKS][BLOCK_SIZE];
+#endif
+  EndpointSize sizes[MAX_ENDPOINTS]; // most recently used first
+
+  EndpointSize& moveToFront(int i);
+
+public:
+  /*! \fn ParseBufferPool()
+   *  \brief Constructor of ParseBufferPool object
+   */
+  ParseBufferPool();
+
+  /*! \fn char* take()
+   *  \brief borrow a buffer of BLOCK_SIZE bytes.
+   *
+   *  \result the buffer, to be handed back with give(), or NULL if
+   *          PARSE_STATIC_BUFFERS is defined and all of them are lent out
+   */
+  char* take();
+
+  /*! \fn void give(char* block)
+   *  \brief hand back a buffer returned by take().
+   *
+   *  \param block - the buffer
+   */
+  void give(char* block);
+
+  /*! \fn static unsigned long endpointHash(const char* httpVerb, const char* httpPath)
+   *  \brief identify an endpoint by its verb and its path without parameters.
+   *
+   *  \result the hash, never 0
+   */
+  static unsigned long endpointHash(const char* httpVerb, const char* httpPath);
+
+  /*! \fn int sizeFor(unsigned long endpoint)
+   *  \brief the largest buffer a response of the endpoint needed so far.
+   *
+   *  \param endpoint - hash from endpointHash()
+   *  \result the size, 0 if not known
+   */
+  int sizeFor(unsigned long endpoint);
+
+  /*! \fn void recordSize(unsigned long endpoint, int size)
+   *  \brief remember the buffer a response of the endpoint needed.
+   *
+   *  \param endpoint - hash from endpointHash()
+   *  \param size - size of the buffer
+   */
+  void recordSize(unsigned long endpoint, int size);
+};
+
+#endif
@@ -27,12 +27,22 @@
 #include "ConnectionClient.h"
 #include "ParseResponse.h"
 #include "ParsePush.h"
+#include "ParseResponseReader.h"
+#include "ParseSessionCache.h"
+#include "ParseOfflineQueue.h"
 
 /*! \file ParseClient.h
  *  \brief ParseClient object for the Yun
  *  include Parse.h, not this file
  */
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+/*! \typedef ParseResponseCallback
+ *  \brief Called by Parse.poll() when a request started with beginRequest() completes.
+ */
+typedef void (*ParseResponseCallback)(ParseResponse& response);
+#endif
+
 /*! \class ParseClient
  *  \brief Class responsible for Parse connection
  */
@@ -56,12 +66,51 @@ private:
   char lastPushTime[41]; // PUSH_TIME_MAX_LEN
   bool dataIsDirty;
   char pushBuff[5];
+  bool keepAlive;
+  bool connectionReusable;
+  ParseResponseReader reader;
+  ParseBufferPool bufferPool;
+  char requestBuffer[536]; // REQUEST_BUFFER_SIZE, the default TCP segment size
 
+  // State of the request started by beginRequest() and driven by poll()
+  enum AsyncState {
+    ASYNC_IDLE,
+    ASYNC_CONNECT,
+    ASYNC_WRITE_HEADERS,
+    ASYNC_WRITE_BODY,
+    ASYNC_READ_RESPONSE
+  };
+  AsyncState asyncState;
+  String asyncVerb;
+  String asyncPath;
+  String asyncBody;
+  String asyncParams;
+  unsigned int asyncBodySent;
+  bool asyncReused;
+  ParseResponseCallback asyncCallback;
+  ParseResponse asyncResponse;
+
+  bool connect();
+  void printHeaders(Print& out, const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams);
+  bool writeRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams);
+  void finishAsyncRequest(bool complete);
   void saveKeys();
   void restoreKeys();
   void saveLastPushTime(char *time);
 #endif
 
+#if defined(ARDUINO_ARCH_ESP8266)
+  ParseSessionCache sessionCache;
+#endif
+
+#if defined (ARDUINO_SAMD_ZERO)
+  ParseOfflineQueue offlineQueue;
+  bool offlineQueueEnabled;
+  bool sendingOfflineQueue;
+
+  bool queueOffline(const String& httpVerb, const String& httpPath, const String& requestBody);
+#endif
+
 public:
   /*! \fn ParseClient()
    *  \brief Constructor of ParseClient object
@@ -114,6 +163,84 @@ public:
    */
   void setClientInsecure();
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn void setKeepAlive(bool keepAlive)
+   *  \brief Enable or disable persistent connections for API requests.
+   *
+   *  When enabled, the connection to the server is left open after a response
+   *  has been read completely and is reused by the next API request, saving
+   *  the TCP and SSL handshake. A connection that was closed by the server in
+   *  the meantime is re-established transparently. Disabled by default.
+   *
+   *  \param  keepAlive     true to reuse connections, false to close them after
+   *                        every request.
+   *
+   */
+  void setKeepAlive(bool keepAlive);
+#endif
+
+#if defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn unsigned long getSessionCacheHits()
+   *  \brief Number of connections that resumed a cached SSL session.
+   *
+   *  The API and push connections share a cache holding the last SSL session of
+   *  each host, so a reconnect only needs an abbreviated handshake.
+   *
+   *  \result                  The number of resumed sessions.
+   */
+  unsigned long getSessionCacheHits();
+
+  /*! \fn unsigned long getSessionCacheMisses()
+   *  \brief Number of connections that needed a full SSL handshake.
+   *
+   *  \result                  The number of full handshakes.
+   */
+  unsigned long getSessionCacheMisses();
+#endif
+
+#if defined (ARDUINO_SAMD_ZERO)
+  /*! \fn void setOfflineQueue(bool enabled)
+   *  \brief Queue writes that cannot reach the server.
+   *
+   *  When enabled, object creates, object updates and events that fail to
+   *  connect are kept in flash and sent later with sendOfflineQueue(), which
+   *  also runs before the next request. The queue survives reboots. When it is
+   *  full, new requests are dropped; queued requests are dropped only when the
+   *  server rejects them. Disabled by default.
+   *
+   *  \param  enabled     true to queue failed writes
+   */
+  void setOfflineQueue(bool enabled);
+
+  /*! \fn bool queueRequest(const String& httpVerb, const String& httpPath, const String& requestBody)
+   *  \brief Add a request to the offline queue without trying to send it.
+   *
+   *  \param   httpVerb - PUT/POST/DELETE
+   *  \param   httpPath - the endpoint of REST API e.g. /classes/Temperature
+   *  \param   requestBody - http request body in json format
+   *  \result  false if the queue is full and the request was dropped
+   */
+  bool queueRequest(const String& httpVerb, const String& httpPath, const String& requestBody);
+
+  /*! \fn bool sendOfflineQueue()
+   *  \brief Send the queued requests, in order and in batches.
+   *
+   *  \result  true if the queue is empty afterwards
+   */
+  bool sendOfflineQueue();
+
+  /*! \fn int getOfflineQueueSize()
+   *  \brief Number of requests waiting in the offline queue.
+   */
+  int getOfflineQueueSize();
+
+  /*! \fn unsigned long getOfflineQueueDropped()
+   *  \brief Number of requests dropped because the offline queue was full or
+   *  the server rejected them.
+   */
+  unsigned long getOfflineQueueDropped();
+#endif
+
   /*! \fn void setInstallationId(const char *installationId)
    *  \brief Set the installation object id for this client.
    *
@@ -202,6 +329,53 @@ public:
    */
   ParseResponse sendRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams);
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn ParseResponse* beginRequest(const char* httpVerb, const char* httpPath, const char* requestBody, const char* urlParams, ParseResponseCallback callback)
+   *  \brief Start a REST API call without waiting for it.
+   *
+   *  The request is carried out step by step by poll(), which has to be called
+   *  repeatedly from loop(). Only one such request can be in progress at a time.
+   *  Opening the connection itself still blocks, since the network libraries
+   *  offer no asynchronous connect; sending the request and reading the response
+   *  never wait for the network.
+   *  \code
+   *  ParseResponse* request = Parse.beginRequest("GET", "/1/classes/Temperature", "", "");
+   *  ...
+   *  Parse.poll();
+   *  if (request && request->ready()) {
+   *    // use request->getString(...), then
+   *    request->close();
+   *    request = NULL;
+   *  }
+   *  \endcode
+   *
+   *  \param   httpVerb - GET/DELETE/PUT/POST
+   *  \param   httpPath - the endpoint of REST API e.g. /installations
+   *  \param   requestBody - http request body in json format, leave it as "" for DELTE/GET requests
+   *  \param   urlParams - leave it as "" unless to perform a Parse query
+   *  \param   callback - called by poll() with the response once it has been read,
+   *            can be NULL
+   *  \result  handle to the response, which stays valid until the next beginRequest(),
+   *           or NULL if another request is still in progress
+   */
+  ParseResponse* beginRequest(const char* httpVerb, const char* httpPath, const char* requestBody, const char* urlParams, ParseResponseCallback callback = NULL);
+
+  /*! \fn ParseResponse* beginRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams, ParseResponseCallback callback)
+   *  \brief Start a REST API call without waiting for it.
+   *
+   *  See beginRequest(const char*, const char*, const char*, const char*, ParseResponseCallback).
+   */
+  ParseResponse* beginRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams, ParseResponseCallback callback = NULL);
+
+  /*! \fn void poll()
+   *  \brief Advance the request started with beginRequest().
+   *
+   *  Does as much work as possible without waiting and returns. Call it from
+   *  loop() until the response is ready().
+   */
+  void poll();
+#endif
+
   /*! \fn int startPushService()
    *  \brief Start the push notifications service.
    *
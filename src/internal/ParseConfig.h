@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseConfig_h
+#define ParseConfig_h
+
+/*! \file ParseConfig.h
+ *  \brief Memory settings of the library for the Zero and ESP8266.
+ *
+ *  Edit the values in this file to change them. The library's own files are
+ *  compiled apart from the sketch, so a #define in the sketch would not reach
+ *  them, and the sketch and the library would disagree on the layout of
+ *  ParseResponse. Defining one of these before including Parse.h is an error
+ *  for that reason.
+ */
+
+#if defined(PARSE_RESPONSE_BUFFER_SIZE) || defined(PARSE_RESPONSE_BUFFERS) || \
+    defined(PARSE_RESPONSE_MAX_SIZE) || defined(PARSE_JSON_INDEX_SIZE) || \
+    defined(PARSE_JSON_MAX_DEPTH) || defined(PARSE_STATIC_BUFFERS)
+#error "Parse memory settings go in src/internal/ParseConfig.h of the library, not in the sketch"
+#endif
+
+// Size of the buffer behind a ParseResponse: the body, followed by the value
+// returned by getString().
+#define PARSE_RESPONSE_BUFFER_SIZE 320
+
+// Most buffers kept for reuse, one per response that is open at the same time.
+#define PARSE_RESPONSE_BUFFERS 3
+
+// Largest body or query result object a response buffer grows to. Anything
+// beyond it is dropped and ParseResponse::isTruncated() tells.
+#define PARSE_RESPONSE_MAX_SIZE 2048
+
+// Most top-level keys of a JSON object that are indexed. Keys past this
+// limit are found by scanning the rest of the object.
+#define PARSE_JSON_INDEX_SIZE 16
+
+// Deepest nesting of objects and arrays in a query result or batch response.
+// A field nested deeper is dropped, see ParseResponse::isTruncated().
+#define PARSE_JSON_MAX_DEPTH 16
+
+// Uncomment to keep the buffers in static memory instead of the heap. No
+// buffer is ever allocated then: a response opened while all of them are lent
+// out gets none, and its body reads as empty. Buffers do not grow either, a
+// body that does not fit is truncated.
+// #define PARSE_STATIC_BUFFERS
+
+#endif // ParseConfig_h
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseFields_h
+#define ParseFields_h
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "ParseJsonExtractor.h"
+
+/*! \file ParseFields.h
+ *  \brief PARSE_FIELDS() for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+// How a member of each supported type is decoded. A member of another type
+// does not compile.
+template <class M> struct ParseFieldOf;
+
+template <> struct ParseFieldOf<int> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_INT;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<long long> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_LONG;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<double> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_DOUBLE;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<bool> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_BOOLEAN;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<float> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_FLOAT;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<unsigned> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_UNSIGNED;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<long> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_SIGNED_LONG;
+  const static uint16_t size = 0;
+};
+
+template <> struct ParseFieldOf<unsigned long> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_UNSIGNED_LONG;
+  const static uint16_t size = 0;
+};
+
+template <size_t N> struct ParseFieldOf<char[N]> {
+  const static uint8_t type = ParseJsonExtractor::TYPE_STRING;
+  const static uint16_t size = N;
+};
+
+// The length of a member name, which must fit in a key of the extractor.
+template <size_t N> struct ParseFieldKey {
+  static_assert(N <= ParseJsonExtractor::KEY_MAX_LEN,
+                "PARSE_FIELDS() member name longer than ParseJsonExtractor::KEY_MAX_LEN");
+  const static uint8_t length = N;
+};
+
+// The entry of member m of struct T, computed at compile time.
+#define PARSE_FIELD(T, m) { \
+  #m, \
+  ParseJsonExtractor::hashKey(#m), \
+  ParseFieldKey<sizeof(#m) - 1>::length, \
+  ParseFieldOf<decltype(T::m)>::type, \
+  offsetof(T, m), \
+  ParseFieldOf<decltype(T::m)>::size }
+
+#define PARSE_FIELDS_GLUE_(a, b) a##b
+#define PARSE_FIELDS_GLUE(a, b) PARSE_FIELDS_GLUE_(a, b)
+#define PARSE_FIELDS_NTH(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define PARSE_FIELDS_COUNT(...) PARSE_FIELDS_NTH(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define PARSE_FIELDS_1(T, m) PARSE_FIELD(T, m)
+#define PARSE_FIELDS_2(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_1(T, __VA_ARGS__)
+#define PARSE_FIELDS_3(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_2(T, __VA_ARGS__)
+#define PARSE_FIELDS_4(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_3(T, __VA_ARGS__)
+#define PARSE_FIELDS_5(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_4(T, __VA_ARGS__)
+#define PARSE_FIELDS_6(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_5(T, __VA_ARGS__)
+#define PARSE_FIELDS_7(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_6(T, __VA_ARGS__)
+#define PARSE_FIELDS_8(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_7(T, __VA_ARGS__)
+#define PARSE_FIELDS_9(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_8(T, __VA_ARGS__)
+#define PARSE_FIELDS_10(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_9(T, __VA_ARGS__)
+#define PARSE_FIELDS_11(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_10(T, __VA_ARGS__)
+#define PARSE_FIELDS_12(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_11(T, __VA_ARGS__)
+#define PARSE_FIELDS_13(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_12(T, __VA_ARGS__)
+#define PARSE_FIELDS_14(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_13(T, __VA_ARGS__)
+#define PARSE_FIELDS_15(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_14(T, __VA_ARGS__)
+#define PARSE_FIELDS_16(T, m, ...) PARSE_FIELD(T, m), PARSE_FIELDS_15(T, __VA_ARGS__)
+
+/*! \def PARSE_FIELDS(T, ...)
+ *  \brief describe which members of struct T are read from the keys of the
+ *  same name, for ParseResponse::nextObject(T& object).
+ *  \code
+ *  struct Reading {
+ *    double temperature;
+ *    bool leverDown;
+ *    char name[16];
+ *  };
+ *  PARSE_FIELDS(Reading, temperature, leverDown, name)
+ *  \endcode
+ *  Members can be int, unsigned, long, unsigned long, long long, float,
+ *  double, bool or char arrays, at most
+ *  ParseJsonExtractor::MAX_FIELDS of them, with names of at most
+ *  ParseJsonExtractor::KEY_MAX_LEN characters. The table of keys and their
+ *  hashes is built at compile time. Use it at file scope, after the struct.
+ */
+#define PARSE_FIELDS(T, ...) \
+  inline const ParseJsonExtractor::Field* parseFields(T*, int* count) { \
+    static const ParseJsonExtractor::Field fields[] = { \
+      PARSE_FIELDS_GLUE(PARSE_FIELDS_, PARSE_FIELDS_COUNT(__VA_ARGS__))(T, __VA_ARGS__) \
+    }; \
+    static_assert(sizeof(fields) / sizeof(fields[0]) <= ParseJsonExtractor::MAX_FIELDS, \
+                  "PARSE_FIELDS() has more than ParseJsonExtractor::MAX_FIELDS members"); \
+    *count = sizeof(fields) / sizeof(fields[0]); \
+    return fields; \
+  }
+
+#endif
@@ -0,0 +1,331 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseInternal.h"
+#include "ParseJsonExtractor.h"
+
+static bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+ParseJsonExtractor::ParseJsonExtractor() {
+  clear();
+}
+
+bool ParseJsonExtractor::add(const char* key, Type type, void* target, int size) {
+  if (wantedCount == MAX_KEYS || !key || !target || strlen(key) > KEY_MAX_LEN)
+    return false;
+  if (type == TYPE_STRING && size <= 0)
+    return false;
+  Wanted& entry = wanted[wantedCount++];
+  entry.key = key;
+  entry.hash = hashKey(key);
+  entry.length = strlen(key);
+  entry.type = type;
+  entry.target = target;
+  entry.size = size;
+  entry.found = false;
+  return true;
+}
+
+bool ParseJsonExtractor::setFields(const Field* fields, int count, void* object) {
+  if (count > MAX_FIELDS || !fields || !object)
+    return false;
+  this->fields = fields;
+  this->object = (char*)object;
+  fieldCount = count;
+  for (int i = 0; i < count; ++i) {
+    storeZero((Type)fields[i].type, this->object + fields[i].offset);
+  }
+  return true;
+}
+
+int ParseJsonExtractor::stride(Type type, int size) {
+  switch (type) {
+    case TYPE_INT:
+      return sizeof(int);
+    case TYPE_LONG:
+      return sizeof(long long);
+    case TYPE_DOUBLE:
+      return sizeof(double);
+    case TYPE_BOOLEAN:
+      return sizeof(bool);
+    case TYPE_FLOAT:
+      return sizeof(float);
+    case TYPE_UNSIGNED:
+      return sizeof(unsigned);
+    case TYPE_SIGNED_LONG:
+      return sizeof(long);
+    case TYPE_UNSIGNED_LONG:
+      return sizeof(unsigned long);
+    case TYPE_STRING:
+      break;
+  }
+  return size;
+}
+
+void ParseJsonExtractor::storeZero(Type type, void* target) {
+  if (type == TYPE_STRING)
+    *(char*)target = 0;
+  else
+    memset(target, 0, stride(type, 0));
+}
+
+void ParseJsonExtractor::startRow(int row) {
+  this->row = row;
+  reset();
+  for (int i = 0; i < wantedCount; ++i) {
+    const Wanted& entry = wanted[i];
+    storeZero(entry.type, (char*)entry.target + row * stride(entry.type, entry.size));
+  }
+}
+
+bool ParseJsonExtractor::isActive() {
+  return wantedCount > 0 || fieldCount > 0;
+}
+
+void ParseJsonExtractor::select(int index, Type type, void* target, int size) {
+  current = index;
+  valueType = type;
+  valueTarget = target;
+  valueSize = size;
+}
+
+void ParseJsonExtractor::startValue() {
+  // The key is complete, see whether its value is wanted. The hash and the
+  // length rule out the other keys, the compare only confirms a match.
+  current = -1;
+  valueLength = 0;
+  if (keyLength > KEY_MAX_LEN)
+    return;
+  for (int i = 0; i < wantedCount; ++i) {
+    const Wanted& entry = wanted[i];
+    if (!entry.found && entry.hash == keyHash && entry.length == keyLength &&
+        !memcmp(entry.key, key, keyLength)) {
+      select(i, entry.type, (char*)entry.target + row * stride(entry.type, entry.size), entry.size);
+      return;
+    }
+  }
+  for (int i = 0; i < fieldCount; ++i) {
+    const Field& field = fields[i];
+    if (!(fieldsFound & 1UL << i) && field.hash == keyHash && field.length == keyLength &&
+        !memcmp(field.key, key, keyLength)) {
+      select(MAX_KEYS + i, (Type)field.type, object + field.offset, field.size);
+      return;
+    }
+  }
+}
+
+void ParseJsonExtractor::capture(char c) {
+  if (current < 0)
+    return;
+  if (valueType == TYPE_STRING) {
+    if (valueLength < valueSize - 1)
+      ((char*)valueTarget)[valueLength++] = c;
+  } else if (valueLength < (int)sizeof(number) - 1) {
+    number[valueLength++] = c;
+  }
+}
+
+void ParseJsonExtractor::finishValue() {
+  if (current < 0)
+    return;
+  if (valueType != TYPE_STRING)
+    number[valueLength] = 0;
+  switch (valueType) {
+    case TYPE_INT:
+      *(int*)valueTarget = ParseUtils::parseLong(number);
+      break;
+    case TYPE_LONG:
+      *(long long*)valueTarget = ParseUtils::parseLong(number);
+      break;
+    case TYPE_DOUBLE:
+      *(double*)valueTarget = ParseUtils::parseDouble(number);
+      break;
+    case TYPE_BOOLEAN:
+      *(bool*)valueTarget = ParseUtils::parseBoolean(number);
+      break;
+    case TYPE_STRING:
+      ((char*)valueTarget)[valueLength] = 0;
+      break;
+    case TYPE_FLOAT:
+      *(float*)valueTarget = ParseUtils::parseDouble(number);
+      break;
+    case TYPE_UNSIGNED:
+      *(unsigned*)valueTarget = ParseUtils::parseLong(number);
+      break;
+    case TYPE_SIGNED_LONG:
+      *(long*)valueTarget = ParseUtils::parseLong(number);
+      break;
+    case TYPE_UNSIGNED_LONG:
+      *(unsigned long*)valueTarget = ParseUtils::parseLong(number);
+      break;
+  }
+  if (current < MAX_KEYS)
+    wanted[current].found = true;
+  else
+    fieldsFound |= 1UL << (current - MAX_KEYS);
+  ++foundCount;
+  current = -1;
+}
+
+void ParseJsonExtractor::feed(char c) {
+  switch (state) {
+    case START:
+      if (c == '{')
+        state = KEY_OR_END;
+      break;
+
+    case KEY_OR_END:
+      if (c == '\"') {
+        keyLength = 0;
+        keyHash = 0;
+        state = KEY;
+      } else if (c == '}') {
+        state = DONE;
+      }
+      break;
+
+    case KEY:
+      if (escape) {
+        escape = false;
+      } else if (c == '\\') {
+        escape = true;
+      } else if (c == '\"') {
+        state = COLON;
+        break;
+      }
+      if (keyLength <= KEY_MAX_LEN) {
+        key[keyLength++] = c;
+        keyHash = hashStep(keyHash, c);
+      }
+      break;
+
+    case COLON:
+      if (c == ':') {
+        startValue();
+        state = VALUE_START;
+      }
+      break;
+
+    case VALUE_START:
+      if (isSpace(c))
+        break;
+      if (c == '\"') {
+        state = VALUE_STRING;
+        break;
+      }
+      capture(c);
+      if (c == '{' || c == '[') {
+        nesting = 1;
+        inString = false;
+        state = VALUE_NESTED;
+      } else {
+        state = VALUE_PRIMITIVE;
+      }
+      break;
+
+    case VALUE_STRING:
+      // Escapes are kept as they are, like getString() does.
+      if (escape) {
+        escape = false;
+      } else if (c == '\\') {
+        escape = true;
+      } else if (c == '\"') {
+        finishValue();
+        state = AFTER_VALUE;
+        break;
+      }
+      capture(c);
+      break;
+
+    case VALUE_NESTED:
+      capture(c);
+      if (inString) {
+        if (escape)
+          escape = false;
+        else if (c == '\\')
+          escape = true;
+        else if (c == '\"')
+          inString = false;
+      } else if (c == '\"') {
+        inString = true;
+      } else if (c == '{' || c == '[') {
+        ++nesting;
+      } else if ((c == '}' || c == ']') && !--nesting) {
+        finishValue();
+        state = AFTER_VALUE;
+      }
+      break;
+
+    case VALUE_PRIMITIVE:
+      if (c != ',' && c != '}' && !isSpace(c)) {
+        capture(c);
+        break;
+      }
+      finishValue();
+      state = AFTER_VALUE;
+      // Fall through
+    case AFTER_VALUE:
+      if (c == ',')
+        state = KEY_OR_END;
+      else if (c == '}')
+        state = DONE;
+      break;
+
+    case DONE:
+      break;
+  }
+}
+
+bool ParseJsonExtractor::isDone() {
+  return state == DONE;
+}
+
+bool ParseJsonExtractor::allFound() {
+  return foundCount == wantedCount + fieldCount;
+}
+
+void ParseJsonExtractor::reset() {
+  state = START;
+  inString = false;
+  escape = false;
+  nesting = 0;
+  keyLength = 0;
+  keyHash = 0;
+  current = -1;
+  valueLength = 0;
+  foundCount = 0;
+  fieldsFound = 0;
+  for (int i = 0; i < wantedCount; ++i) {
+    wanted[i].found = false;
+  }
+}
+
+void ParseJsonExtractor::clear() {
+  wantedCount = 0;
+  row = 0;
+  fields = NULL;
+  fieldCount = 0;
+  object = NULL;
+  reset();
+}
@@ -0,0 +1,228 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseJsonExtractor_h
+#define ParseJsonExtractor_h
+
+#include <Arduino.h>
+
+/*! \file ParseJsonExtractor.h
+ *  \brief ParseJsonExtractor object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseJsonExtractor
+ *  \brief Picks the values of chosen top-level keys out of a JSON object
+ *  while it is streamed in, one character at a time.
+ *
+ *  Only the values of the chosen keys are kept, so the object itself never has
+ *  to fit in memory. Nesting is tracked with a counter, not recursion. Keys
+ *  are hashed as they are read and matched on their hash and length first.
+ *
+ *  The keys are chosen one by one with add(), or as the table of fields of a
+ *  struct with setFields(), see PARSE_FIELDS().
+ */
+class ParseJsonExtractor {
+public:
+  enum Type {
+    TYPE_INT,
+    TYPE_LONG,
+    TYPE_DOUBLE,
+    TYPE_BOOLEAN,
+    TYPE_STRING,
+    TYPE_FLOAT,
+    TYPE_UNSIGNED,
+    TYPE_SIGNED_LONG,
+    TYPE_UNSIGNED_LONG
+  };
+
+  /*! \var MAX_KEYS
+   *  \brief the most keys that can be chosen.
+   */
+  const static int MAX_KEYS = 8;
+
+  /*! \var KEY_MAX_LEN
+   *  \brief the longest key that can be chosen.
+   */
+  const static int KEY_MAX_LEN = 31;
+
+  /*! \var MAX_FIELDS
+   *  \brief the most fields in a table given to setFields().
+   */
+  const static int MAX_FIELDS = 16;
+
+  /*! \struct Field
+   *  \brief a key and the member of a struct its value is stored in, see
+   *  PARSE_FIELDS().
+   */
+  struct Field {
+    const char* key;
+    uint16_t hash;   // hashKey(key)
+    uint8_t length;  // lengthOf(key)
+    uint8_t type;    // Type of the member
+    uint16_t offset; // of the member in the struct
+    uint16_t size;   // of a char array member, 0 otherwise
+  };
+
+  /*! \fn static constexpr uint16_t hashStep(uint16_t hash, char c)
+   *  \brief add the next character of a key to its hash.
+   */
+  static constexpr uint16_t hashStep(uint16_t hash, char c) {
+    return (uint16_t)(hash << 5 | hash >> 11) ^ (uint8_t)c;
+  }
+
+  /*! \fn static constexpr uint16_t hashKey(const char* key, uint16_t hash)
+   *  \brief hash of a key, computed at compile time for a literal.
+   */
+  static constexpr uint16_t hashKey(const char* key, uint16_t hash = 0) {
+    return *key ? hashKey(key + 1, hashStep(hash, *key)) : hash;
+  }
+
+  /*! \fn static constexpr int lengthOf(const char* key)
+   *  \brief length of a key, computed at compile time for a literal.
+   */
+  static constexpr int lengthOf(const char* key) {
+    return *key ? 1 + lengthOf(key + 1) : 0;
+  }
+
+private:
+  struct Wanted {
+    const char* key;
+    uint16_t hash;
+    uint8_t length;
+    Type type;
+    void* target;
+    int size;
+    bool found;
+  };
+
+  enum State {
+    START,
+    KEY_OR_END,
+    KEY,
+    COLON,
+    VALUE_START,
+    VALUE_STRING,
+    VALUE_NESTED,
+    VALUE_PRIMITIVE,
+    AFTER_VALUE,
+    DONE
+  };
+
+  Wanted wanted[MAX_KEYS];
+  int wantedCount;
+  const Field* fields;
+  int fieldCount;
+  char* object;
+  unsigned long fieldsFound; // bit i is set when fields[i] is found
+  int foundCount;
+
+  State state;
+  bool inString;
+  bool escape;
+  int nesting;
+  char key[KEY_MAX_LEN + 1];
+  int keyLength;
+  uint16_t keyHash;
+  int current; // index in wanted, or MAX_KEYS + index in fields, of the value being read, -1 if not wanted
+  Type valueType;
+  void* valueTarget;
+  int valueSize;
+  char number[32]; // NUMBER_MAX_LEN, value of a non-string target
+  int valueLength;
+  int row;
+
+  static int stride(Type type, int size);
+  static void storeZero(Type type, void* target);
+  void select(int index, Type type, void* target, int size);
+  void startValue();
+  void capture(char c);
+  void finishValue();
+
+public:
+  /*! \fn ParseJsonExtractor()
+   *  \brief Constructor of ParseJsonExtractor object
+   */
+  ParseJsonExtractor();
+
+  /*! \fn bool add(const char* key, Type type, void* target, int size)
+   *  \brief choose a key and where to store its value.
+   *
+   *  \param key - the key, which has to stay valid while the object is read
+   *  \param type - how to convert the value
+   *  \param target - a variable of the type, or a char buffer for TYPE_STRING,
+   *                 or an array of them, see startRow()
+   *  \param size - size of the char buffer for TYPE_STRING
+   *  \result false if MAX_KEYS keys are already chosen or key is too long
+   */
+  bool add(const char* key, Type type, void* target, int size);
+
+  /*! \fn bool setFields(const Field* fields, int count, void* object)
+   *  \brief choose the keys of a table of fields, and the struct to store
+   *  their values in. Each member is set to 0 or "" first, so that a key
+   *  missing from the object does not leave the value of an earlier one.
+   *
+   *  \param fields - the table, which has to stay valid while the object is read
+   *  \param count - number of fields in the table
+   *  \param object - the struct
+   *  \result false if the table has more than MAX_FIELDS fields
+   */
+  bool setFields(const Field* fields, int count, void* object);
+
+  /*! \fn void startRow(int row)
+   *  \brief start over with a new object whose values go to element row of
+   *  the arrays given to add(). The elements are set to 0 or "" first.
+   */
+  void startRow(int row);
+
+  /*! \fn bool isActive()
+   *  \brief whether any key is chosen.
+   */
+  bool isActive();
+
+  /*! \fn void feed(char c)
+   *  \brief process the next character of the object.
+   */
+  void feed(char c);
+
+  /*! \fn bool isDone()
+   *  \brief whether the end of the object was read.
+   */
+  bool isDone();
+
+  /*! \fn bool allFound()
+   *  \brief whether a value was stored for every chosen key.
+   */
+  bool allFound();
+
+  /*! \fn void reset()
+   *  \brief start over with a new object, keeping the chosen keys.
+   */
+  void reset();
+
+  /*! \fn void clear()
+   *  \brief forget the chosen keys.
+   */
+  void clear();
+};
+
+#endif
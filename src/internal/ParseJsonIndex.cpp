@@ -0,0 +1,299 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseInternal.h"
+#include "ParseJsonIndex.h"
+
+ParseJsonIndex::ParseJsonIndex() {
+  clear();
+}
+
+uint8_t ParseJsonIndex::hashKey(const char* key, int length) {
+  uint8_t hash = length;
+  while (length--) {
+    hash = (hash << 1 | hash >> 7) ^ (uint8_t)*key++;
+  }
+  return hash;
+}
+
+const char* ParseJsonIndex::skipSpace(const char* p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+    ++p;
+  return p;
+}
+
+const char* ParseJsonIndex::skipString(const char* p) {
+  // p is on the opening quote; returns the position after the closing one.
+  for (++p; *p; ++p) {
+    if (*p == '\\') {
+      if (!*++p)
+        return NULL;
+    } else if (*p == '\"') {
+      return p + 1;
+    }
+  }
+  return NULL;
+}
+
+const char* ParseJsonIndex::skipValue(const char* p) {
+  if (*p == '\"')
+    return skipString(p);
+
+  int level = 0;
+  for (; *p; ++p) {
+    switch (*p) {
+      case '\"':
+        p = skipString(p);
+        if (!p)
+          return NULL;
+        --p;
+        break;
+      case '{':
+      case '[':
+        ++level;
+        break;
+      case '}':
+      case ']':
+        if (!level)
+          return p;
+        if (!--level)
+          return p + 1;
+        break;
+      case ',':
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        if (!level)
+          return p;
+        break;
+    }
+  }
+  // The value runs to the end of the text, so it may be cut short.
+  return NULL;
+}
+
+bool ParseJsonIndex::nextEntry(const char*& p, const char** key, int* keyLength, const char** value, int* valueLength) {
+  // p is on a key, or on the closing brace of the object.
+  if (*p != '\"')
+    return false;
+  *key = p + 1;
+  p = skipString(p);
+  if (!p)
+    return false;
+  *keyLength = p - 1 - *key;
+  p = skipSpace(p);
+  if (*p != ':')
+    return false;
+  *value = skipSpace(p + 1);
+  p = skipValue(*value);
+  if (!p || p == *value)
+    return false;
+  *valueLength = p - *value;
+
+  // A body cut short after a complete value still yields that value.
+  p = skipSpace(p);
+  if (*p == ',')
+    p = skipSpace(p + 1);
+  else if (*p != '}' && *p)
+    return false;
+  return true;
+}
+
+void ParseJsonIndex::build(const char* json) {
+  this->json = json;
+  size = 0;
+  overflow = NULL;
+  if (!json)
+    return;
+
+  const char* p = skipSpace(json);
+  isObject = *p == '{';
+  if (!isObject)
+    return;
+  p = skipSpace(p + 1);
+
+  const char* key;
+  const char* value;
+  int keyLength;
+  int valueLength;
+  const char* entryStart = p;
+  while (nextEntry(p, &key, &keyLength, &value, &valueLength)) {
+    if (size == PARSE_JSON_INDEX_SIZE || keyLength > 255 || p - json > 0xFFFF) {
+      // The rest of the object is scanned by find() when it is needed.
+      overflow = entryStart;
+      return;
+    }
+    Entry& entry = entries[size++];
+    entry.key = key - json;
+    entry.keyLength = keyLength;
+    entry.hash = hashKey(key, keyLength);
+    entry.value = value - json;
+    entry.valueLength = valueLength;
+    entryStart = p;
+  }
+}
+
+void ParseJsonIndex::clear() {
+  json = NULL;
+  size = 0;
+  isObject = false;
+  overflow = NULL;
+}
+
+bool ParseJsonIndex::isBuilt() {
+  return json != NULL;
+}
+
+bool ParseJsonIndex::findMember(const char* object, const char* key, int keyLength, const char** value, int* length) {
+  if (*object != '{')
+    return false;
+  const char* p = skipSpace(object + 1);
+  const char* found;
+  int foundLength;
+  while (nextEntry(p, &found, &foundLength, value, length)) {
+    if (foundLength == keyLength && !memcmp(found, key, keyLength))
+      return true;
+  }
+  return false;
+}
+
+bool ParseJsonIndex::findElement(const char* array, int n, const char** value, int* length) {
+  if (*array != '[')
+    return false;
+  const char* p = skipSpace(array + 1);
+  for (; n > 0; --n) {
+    p = skipValue(p);
+    if (!p)
+      return false;
+    p = skipSpace(p);
+    if (*p != ',')
+      return false;
+    p = skipSpace(p + 1);
+  }
+  const char* end = skipValue(p);
+  if (!end || end == p)
+    return false;
+  *value = p;
+  *length = end - p;
+  return true;
+}
+
+bool ParseJsonIndex::find(const char* key, const char** value, int* length) {
+  if (findKey(key, strlen(key), value, length))
+    return true;
+  return (strchr(key, '.') || strchr(key, '[')) && findPath(key, value, length);
+}
+
+bool ParseJsonIndex::findPath(const char* path, const char** value, int* length) {
+  // Only the first key is looked up in the index, every later step walks the
+  // value found so far. Nothing is copied.
+  const char* p = path;
+  if (*p == '[') {
+    // An element of a top-level array, e.g. "[0].success.objectId"
+    if (!json)
+      return false;
+    *value = skipSpace(json);
+  } else {
+    int keyLength = strcspn(p, ".[");
+    if (!findKey(p, keyLength, value, length))
+      return false;
+    p += keyLength;
+  }
+
+  while (*p) {
+    if (*p == '.') {
+      int keyLength = strcspn(++p, ".[");
+      if (!keyLength || !findMember(*value, p, keyLength, value, length))
+        return false;
+      p += keyLength;
+    } else if (*p == '[') {
+      char* end;
+      long n = strtol(p + 1, &end, 10);
+      if (end == p + 1 || *end != ']' || n < 0 || !findElement(*value, n, value, length))
+        return false;
+      p = end + 1;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseJsonIndex::findKey(const char* key, int keyLength, const char** value, int* length) {
+  uint8_t hash = hashKey(key, keyLength);
+  for (int i = 0; i < size; ++i) {
+    const Entry& entry = entries[i];
+    if (entry.hash == hash && entry.keyLength == keyLength &&
+        !memcmp(json + entry.key, key, keyLength)) {
+      *value = json + entry.value;
+      *length = entry.valueLength;
+      return true;
+    }
+  }
+
+  const char* p = overflow;
+  const char* found;
+  int foundLength;
+  if (p) {
+    while (nextEntry(p, &found, &foundLength, value, length)) {
+      if (foundLength == keyLength && !memcmp(found, key, keyLength))
+        return true;
+    }
+  }
+  return false;
+}
+
+const char* ParseJsonIndex::findValue(const char* key) {
+  const char* value;
+  int length;
+  if (!key || !*key)
+    return NULL;
+  if (find(key, &value, &length))
+    return value;
+  return isObject ? NULL : ParseUtils::findValueInJSON(json, key);
+}
+
+int ParseJsonIndex::getStringValue(const char* key, char* value, int size) {
+  const char* found;
+  int length;
+  if (!key || !*key)
+    return 0;
+  if (!find(key, &found, &length)) {
+    // Keys of objects in a top-level array are still found by the old scan.
+    if (!isObject && json)
+      return ParseUtils::getStringFromJSON(json, key, value, size);
+    return 0;
+  }
+  if (!value)
+    return 1;
+
+  if (*found == '\"') {
+    ++found;
+    length -= 2;
+  }
+  if (length > size - 1)
+    length = size - 1;
+  memcpy(value, found, length);
+  value[length] = 0;
+  return 1;
+}
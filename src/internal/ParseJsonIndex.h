@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseJsonIndex_h
+#define ParseJsonIndex_h
+
+#include <Arduino.h>
+#include "ParseConfig.h"
+
+/*! \file ParseJsonIndex.h
+ *  \brief ParseJsonIndex object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseJsonIndex
+ *  \brief Offsets of the top-level keys and values of a JSON object.
+ *
+ *  The object is tokenized once by build(), after which each lookup compares
+ *  a few indexed keys instead of scanning the whole text again. A path such
+ *  as "location.latitude" or "results[3].name" starts from the indexed key
+ *  and walks the rest of its value in place.
+ */
+class ParseJsonIndex {
+private:
+  struct Entry {
+    uint16_t key; // offset of the key, after its opening quote
+    uint16_t value; // offset of the value
+    uint16_t valueLength; // length of the value, quotes included
+    uint8_t keyLength;
+    uint8_t hash;
+  };
+
+  Entry entries[PARSE_JSON_INDEX_SIZE];
+  int size;
+  const char* json;
+  const char* overflow; // first key that did not fit the index
+  bool isObject;
+
+  static uint8_t hashKey(const char* key, int length);
+  static const char* skipSpace(const char* p);
+  static const char* skipString(const char* p);
+  static const char* skipValue(const char* p);
+  static bool nextEntry(const char*& p, const char** key, int* keyLength, const char** value, int* valueLength);
+  static bool findMember(const char* object, const char* key, int keyLength, const char** value, int* length);
+  static bool findElement(const char* array, int n, const char** value, int* length);
+  bool findKey(const char* key, int keyLength, const char** value, int* length);
+  bool findPath(const char* path, const char** value, int* length);
+
+public:
+  /*! \fn ParseJsonIndex()
+   *  \brief Constructor of ParseJsonIndex object
+   */
+  ParseJsonIndex();
+
+  /*! \fn void build(const char* json)
+   *  \brief index the top-level keys of a JSON object.
+   *
+   *  \param json - the object, which has to stay unchanged while the index is used
+   */
+  void build(const char* json);
+
+  /*! \fn void clear()
+   *  \brief forget the indexed object.
+   */
+  void clear();
+
+  /*! \fn bool isBuilt()
+   *  \brief whether build() was called since the last clear().
+   */
+  bool isBuilt();
+
+  /*! \fn bool find(const char* key, const char** value, int* length)
+   *  \brief look up the raw value of a top-level key, or of a path.
+   *
+   *  A key that is not found and contains '.' or '[' is taken as a path:
+   *  keys of nested objects are separated by dots, array elements are
+   *  numbered from 0 in brackets, e.g. "results[3].name".
+   *  \param key - key or path to find
+   *  \param value - set to the start of the value, quotes included
+   *  \param length - set to the length of the value
+   *  \result true if found
+   */
+  bool find(const char* key, const char** value, int* length);
+
+  /*! \fn const char* findValue(const char* key)
+   *  \brief look up where the value of a key starts, for parsing it in place.
+   *
+   *  Unlike find(), this also finds keys of objects in a top-level array, as
+   *  ParseUtils::findValueInJSON() does.
+   *  \param key - key to find
+   *  \result start of the value, or NULL if not found
+   */
+  const char* findValue(const char* key);
+
+  /*! \fn int getStringValue(const char* key, char* value, int size)
+   *  \brief same as ParseUtils::getStringFromJSON(), answered from the index.
+   *
+   *  \param key - key to find
+   *  \param value - returned value (always as string)
+   *  \param size - size of the return buffer
+   *  \result 1 if found 0 otherwise
+   */
+  int getStringValue(const char* key, char* value, int size);
+};
+
+#endif
@@ -98,3 +98,12 @@ ParseResponse ParseObjectCreate::send() {
 	}
 	return Parse.sendRequest("POST", httpPath, requestBody, "");
 }
+
+#if defined (ARDUINO_SAMD_ZERO)
+bool ParseObjectCreate::sendLater() {
+	if (!isBodySet) {
+		requestBody += "}";
+	}
+	return Parse.queueRequest("POST", httpPath, requestBody);
+}
+#endif
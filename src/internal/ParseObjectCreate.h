@@ -119,6 +119,16 @@ public:
    *
    */
   virtual ParseResponse send();
+
+#if defined (ARDUINO_SAMD_ZERO)
+  /*! \fn virtual bool sendLater()
+   *  \brief add the object creation to the offline queue instead of sending it.
+   *
+   *  The queue is sent by Parse.sendOfflineQueue() or before the next request.
+   *  \result false if the queue is full
+   */
+  virtual bool sendLater();
+#endif
 };
 
 #endif
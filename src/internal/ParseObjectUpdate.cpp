@@ -34,3 +34,12 @@ ParseResponse ParseObjectUpdate::send() {
 
 	return Parse.sendRequest("PUT", httpPath, requestBody, "");
 }
+
+#if defined (ARDUINO_SAMD_ZERO)
+bool ParseObjectUpdate::sendLater() {
+	if (!isBodySet) {
+		requestBody += "}";
+	}
+	return Parse.queueRequest("PUT", httpPath, requestBody);
+}
+#endif
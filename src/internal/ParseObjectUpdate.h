@@ -45,6 +45,15 @@ public:
    *  \result the response
    */
   ParseResponse send();
+
+#if defined (ARDUINO_SAMD_ZERO)
+  /*! \fn bool sendLater() override
+   *  \brief add the update to the offline queue instead of sending it.
+   *
+   *  \result false if the queue is full
+   */
+  bool sendLater();
+#endif
 };
 
 #endif
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseInternal.h"
+#include "ParseObjectView.h"
+
+ParseObjectView::ParseObjectView(ParseJsonIndex& index, const char* json) : index(index), json(json) {
+}
+
+bool ParseObjectView::exists(const char* key) {
+  const char* value;
+  int length;
+  return key && index.find(key, &value, &length);
+}
+
+int ParseObjectView::getInt(const char* key) {
+  return ParseUtils::parseLong(index.findValue(key));
+}
+
+long long ParseObjectView::getLong(const char* key) {
+  return ParseUtils::parseLong(index.findValue(key));
+}
+
+double ParseObjectView::getDouble(const char* key) {
+  return ParseUtils::parseDouble(index.findValue(key));
+}
+
+bool ParseObjectView::getBoolean(const char* key) {
+  return ParseUtils::parseBoolean(index.findValue(key));
+}
+
+ParseStringView ParseObjectView::getStringView(const char* key) {
+  const char* value;
+  int length;
+  if (!key || !index.find(key, &value, &length))
+    return ParseStringView();
+  return ParseStringView(value, length);
+}
+
+const char* ParseObjectView::getJSON() {
+  return json;
+}
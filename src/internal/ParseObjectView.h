@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseObjectView_h
+#define ParseObjectView_h
+
+#include <Arduino.h>
+#include "ParseJsonIndex.h"
+#include "ParseStringView.h"
+
+/*! \file ParseObjectView.h
+ *  \brief ParseObjectView object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseObjectView
+ *  \brief The fields of one object of a query result, handed to the callback
+ *  of ParseResponse::forEachObject().
+ *
+ *  The view reads the object in place through the index of the response, so
+ *  it is only valid inside the callback. Keys can be paths, as with the
+ *  getters of ParseResponse.
+ */
+class ParseObjectView {
+private:
+  ParseJsonIndex& index;
+  const char* json;
+
+public:
+  /*! \fn ParseObjectView(ParseJsonIndex& index, const char* json)
+   *  \brief Constructor of ParseObjectView object
+   *
+   *  \param index - index built over json
+   *  \param json - the object
+   */
+  ParseObjectView(ParseJsonIndex& index, const char* json);
+
+  /*! \fn bool exists(const char* key)
+   *  \brief whether the object has a value for key.
+   */
+  bool exists(const char* key);
+
+  /*! \fn int getInt(const char* key)
+   *  \brief get the integer value of the object by key.
+   */
+  int getInt(const char* key);
+
+  /*! \fn long long getLong(const char* key)
+   *  \brief get the 64-bit integer value of the object by key.
+   */
+  long long getLong(const char* key);
+
+  /*! \fn double getDouble(const char* key)
+   *  \brief get the double value of the object by key.
+   */
+  double getDouble(const char* key);
+
+  /*! \fn bool getBoolean(const char* key)
+   *  \brief get the boolean value of the object by key.
+   */
+  bool getBoolean(const char* key);
+
+  /*! \fn ParseStringView getStringView(const char* key)
+   *  \brief get a value of the object by key without copying it.
+   *
+   *  \result the value, or an empty view if key is not found
+   */
+  ParseStringView getStringView(const char* key);
+
+  /*! \fn const char* getJSON()
+   *  \brief the object as JSON, without the fields that were dropped for
+   *  being too large (see ParseResponse::isTruncated()).
+   */
+  const char* getJSON();
+};
+
+#endif
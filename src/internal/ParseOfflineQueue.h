@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef ParseOfflineQueue_h
+#define ParseOfflineQueue_h
+
+#include <Arduino.h>
+
+#if defined (ARDUINO_SAMD_ZERO)
+
+/*! \file ParseOfflineQueue.h
+ *  \brief ParseOfflineQueue object for the Zero
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseOfflineQueue
+ *  \brief Log of requests waiting to be sent, kept in flash across reboots.
+ *  This object is owned by ParseClient.
+ *
+ *  Requests are appended to a fixed region of flash and marked sent in order.
+ *  Flash can only be erased as a whole region here, so once the log is full
+ *  new requests are dropped until the queued ones have been sent.
+ */
+class ParseOfflineQueue {
+private:
+  struct Record {
+    uint32_t info; // RECORD_MAGIC in the high half, data length in the low half
+    uint32_t state; // 0xFFFFFFFF while pending, 0 once sent
+  };
+
+  bool loaded;
+  int writePos;
+  int readPos;
+  int pending;
+  bool erased; // the flash after writePos is erased and can take new records
+  unsigned long dropped;
+
+  uint32_t readWord(int pos);
+  int recordSize(uint32_t info);
+  void program(int pos, const void* data, int size);
+  void readString(int& pos, String& value);
+  void reset();
+
+public:
+  /*! \var QUEUE_SIZE
+   *  \brief bytes of flash reserved for the log.
+   */
+  const static int QUEUE_SIZE = 4096;
+
+  /*! \fn ParseOfflineQueue()
+   *  \brief Constructor of ParseOfflineQueue object
+   */
+  ParseOfflineQueue();
+
+  /*! \fn void begin()
+   *  \brief load the requests left in flash by the last run.
+   *  The other methods call it on first use.
+   */
+  void begin();
+
+  /*! \fn bool push(const String& httpVerb, const String& httpPath, const String& requestBody)
+   *  \brief append a request to the log.
+   *
+   *  \result false if the log is full and the request was dropped
+   */
+  bool push(const String& httpVerb, const String& httpPath, const String& requestBody);
+
+  /*! \fn int first()
+   *  \brief position of the oldest pending request, -1 if there is none.
+   */
+  int first();
+
+  /*! \fn int next(int pos)
+   *  \brief position of the pending request after pos, -1 if there is none.
+   */
+  int next(int pos);
+
+  /*! \fn void get(int pos, String& httpVerb, String& httpPath, String& requestBody)
+   *  \brief read the request at pos.
+   */
+  void get(int pos, String& httpVerb, String& httpPath, String& requestBody);
+
+  /*! \fn void remove(int count)
+   *  \brief mark the count oldest pending requests as sent.
+   */
+  void remove(int count);
+
+  /*! \fn void drop(int count)
+   *  \brief mark the count oldest pending requests as sent and count them
+   *  as dropped, for requests the server rejected.
+   */
+  void drop(int count);
+
+  /*! \fn int size()
+   *  \brief number of pending requests.
+   */
+  int size();
+
+  /*! \fn unsigned long getDropped()
+   *  \brief number of requests dropped because the log was full or the
+   *  server rejected them.
+   */
+  unsigned long getDropped();
+};
+
+#endif // ARDUINO_SAMD_ZERO
+
+#endif
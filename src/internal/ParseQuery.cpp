@@ -29,6 +29,9 @@ ParseQuery::ParseQuery() : ParseRequest() {
 	skip = -1;
 	order = "";
 	returnedFields = "";
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+	onlyCount = false;
+#endif
 }
 
 long getDecimal(double v) {
@@ -164,6 +167,12 @@ void ParseQuery::setKeys(const char* keys) {
 	returnedFields = keys;
 }
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+void ParseQuery::countOnly() {
+	onlyCount = true;
+}
+#endif
+
 ParseResponse ParseQuery::send() {
   String urlParameters = "";
   if (whereClause != "") {
@@ -172,6 +181,11 @@ ParseResponse ParseQuery::send() {
     urlParameters += whereClause;
   } 
   
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+	if (onlyCount) {
+		urlParameters += "&limit=0&count=1";
+	} else
+#endif
 	if (limit>0) {
 		urlParameters += "&limit=";
 		urlParameters += limit;
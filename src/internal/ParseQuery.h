@@ -39,6 +39,9 @@ private:
 	String returnedFields;
 	int limit;
 	int skip;
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+	bool onlyCount;
+#endif
 	void addConditionKey(const char* key);
 	void addConditionNum(const char* key, const char* comparator, double value);
 public:
@@ -233,6 +236,25 @@ public:
    */
   void orderBy(const char* keys);
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn void countOnly()
+   *  \brief ask the server for the number of matching objects only.
+   *
+   *  No objects are sent back; ParseResponse::count() returns the exact
+   *  number of objects matching the query:
+   *  \code
+   *  ParseQuery query;
+   *  query.setClassName("Temperature");
+   *  query.whereGreaterThan("value", 30);
+   *  query.countOnly();
+   *  ParseResponse response = query.send();
+   *  int hot = response.count();
+   *  response.close();
+   *  \endcode
+   */
+  void countOnly();
+#endif
+
   /*! \fn ParseResponse send() override
    *  \brief launch query and execute
    *
@@ -38,6 +38,7 @@ protected:
 	String httpPath;
 	String requestBody;
 	bool isBodySet;
+	friend class ParseBatch;
 public:
   /*! \fn ParseRequest()
    *  \brief Constructor of ParseRequest object
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseRequestWriter.h"
+
+ParseRequestWriter::ParseRequestWriter(Print& out, char* buffer, size_t size, bool echo) :
+  out(out), buffer(buffer), size(size), used(0), echo(echo), failed(false) {
+}
+
+void ParseRequestWriter::flushBuffer() {
+  if (!used)
+    return;
+  if (out.write((const uint8_t*)buffer, used) != used)
+    failed = true;
+  if (echo)
+    Serial.write((const uint8_t*)buffer, used);
+  used = 0;
+}
+
+size_t ParseRequestWriter::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t ParseRequestWriter::write(const uint8_t* data, size_t len) {
+  size_t left = len;
+  while (left) {
+    if (used == size)
+      flushBuffer();
+    size_t n = (left < size - used) ? left : size - used;
+    memcpy(buffer + used, data, n);
+    used += n;
+    data += n;
+    left -= n;
+  }
+  return len;
+}
+
+int ParseRequestWriter::availableForWrite() {
+  return size - used;
+}
+
+bool ParseRequestWriter::finish() {
+  flushBuffer();
+  return !failed;
+}
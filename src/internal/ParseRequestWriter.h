@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseRequestWriter_h
+#define ParseRequestWriter_h
+
+#include <Arduino.h>
+
+/*! \file ParseRequestWriter.h
+ *  \brief ParseRequestWriter object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseRequestWriter
+ *  \brief Coalesces the pieces of an HTTP request into as few writes as possible.
+ *
+ *  Everything printed is collected in the given buffer, which is written to the
+ *  connection only when it is full or when finish() is called. Over SSL every
+ *  write becomes its own record, so this keeps a request to one or two records.
+ */
+class ParseRequestWriter : public Print {
+private:
+  Print& out;
+  char* buffer;
+  size_t size;
+  size_t used;
+  bool echo;
+  bool failed;
+
+  void flushBuffer();
+
+public:
+  /*! \fn ParseRequestWriter(Print& out, char* buffer, size_t size, bool echo)
+   *  \brief Constructor of ParseRequestWriter object
+   *
+   *  \param out - the connection to write to
+   *  \param buffer - buffer to collect the request in
+   *  \param size - size of buffer
+   *  \param echo - also print everything written to Serial
+   */
+  ParseRequestWriter(Print& out, char* buffer, size_t size, bool echo);
+
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t* data, size_t len);
+  using Print::write;
+
+  /*! \fn int availableForWrite()
+   *  \brief number of bytes that still fit before the buffer is written out.
+   */
+  virtual int availableForWrite();
+
+  /*! \fn bool finish()
+   *  \brief write out whatever is left in the buffer.
+   *
+   *  \result true if the whole request was accepted by the connection
+   */
+  bool finish();
+};
+
+#endif
@@ -23,19 +23,52 @@
 #define ParseResponse_h
 
 #include "ConnectionClient.h"
+#include "ParseBufferPool.h"
+#include "ParseJsonIndex.h"
+#include "ParseStringView.h"
+#include "ParseJsonExtractor.h"
+#include "ParseFields.h"
+#include "ParseObjectView.h"
 
 /*! \file ParseResponse.h
  *  \brief ParseResponse object for the Yun
  *  include Parse.h, not this file
  */
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+/*! \typedef ParseBodyCallback
+ *  \brief Called by ParseResponse::writeTo() with each piece of the body.
+ */
+typedef void (*ParseBodyCallback)(const char* data, int length);
+
+/*! \typedef ParseObjectCallback
+ *  \brief Called by ParseResponse::forEachObject() with each object, returns
+ *  false to stop.
+ */
+typedef bool (*ParseObjectCallback)(ParseObjectView& object);
+#endif
+
 /*! \class ParseResponse
  *  \brief Class that encapsulates Rest API response.
  *  This object created indirectly.
  */
 class ParseResponse {
 protected:
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  // Everything a response allocates is cut from one pooled block, which goes
+  // back to the pool in close(): the body and the value for getString().
+  // A body too large for the block moves to a heap buffer that doubles in
+  // size up to PARSE_RESPONSE_MAX_SIZE.
+  const static int TMPBUFSIZE = 64;
+  const static int BUFSIZE = ParseBufferPool::BLOCK_SIZE - TMPBUFSIZE;
+  char* block;
+  int blockUsed;
+  char* grown;
+  bool truncated;
+  unsigned long endpoint; // see ParseBufferPool::endpointHash(), 0 if unknown
+#else
   const static int BUFSIZE = 128;
+#endif
   int bufSize;
   char* buf;
   char* tmpBuf;
@@ -44,12 +77,44 @@ protected:
   int resultCount;
 #if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
   long responseLength;
-  bool isChunked;
   bool firstObject;
   bool dataDone;
-  char chunkedBuffer[1024];
-  int bufferPos;
-  int lastRead;
+  bool isBatch;
+  bool stopWhenFound;
+  bool complete;
+  bool timedOut; // the server stopped sending for kResponseTimeout
+  bool queued;
+  Print* sink;
+
+  // State of the incremental reader used by readAvailable()
+  enum ReadState {
+    READ_STATUS,
+    READ_HEADERS,
+    READ_BODY,
+    READ_CHUNK_SIZE,
+    READ_CHUNK_DATA,
+    READ_CHUNK_END,
+    READ_TRAILER,
+    READ_DONE
+  };
+  ReadState readState;
+  char line[64];
+  int linePos;
+  long chunkRemaining;
+
+  // Status line and headers, filled in by processLine() as they arrive
+  struct HttpHeaders {
+    int status;
+    long contentLength; // -1 if not sent
+    bool chunked;
+    bool keepAlive;
+    long retryAfter;    // seconds, -1 if not sent
+    char date[30];      // e.g. "Tue, 15 Nov 1994 08:12:31 GMT"
+  };
+  HttpHeaders http;
+  unsigned long lastActivity;
+  ParseJsonIndex jsonIndex;
+  ParseJsonExtractor extractor;
 #endif
   ConnectionClient* client;
 
@@ -58,10 +123,34 @@ protected:
 
 #if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
   // Zero functions only - do nothing on Yun
-  void readLine(char *buff, int sz);
-  bool readJson(char *buff, int sz);
-  bool readJsonInternal(char *buff, int sz, int *read_bytes, char started);
+  int readInput();
+  void reset();
+  char* allocate(int size);
+  void allocateBody();
+  void append(int& length, char c);
+  bool growBody(int length);
+  void dropField(int& length, int start);
+  bool readAvailable();
+  void consume(char c);
+  bool decode(char c);
+  void storeBody(char c);
+  bool writeBlock();
+  void processLine();
+  bool readHeaders();
+  void finishRead(bool complete);
+  void stopReading();
+  void releaseConnection(bool complete);
+  bool readJson();
   int readChunkedData(int timeout);
+  void unwrapBatchResult();
+  int readCount();
+  long openResults();
+  void estimateCount(long skipped, long objectLength);
+  void buildIndex();
+  bool nextFields(const ParseJsonExtractor::Field* fields, int fieldCount, void* object);
+  bool feedNextObject();
+  long feedObject();
+  void markQueued();
   // End Zero only functions
 #endif
 
@@ -70,7 +159,26 @@ protected:
 
   ParseResponse(ConnectionClient* client);
 
+  // Used by the move operations only, the buffers are not shared.
+  ParseResponse& operator=(const ParseResponse& other) = default;
+  void forget();
+
 public:
+  /*! \fn ParseResponse(ParseResponse&& other)
+   *  \brief Move constructor of ParseResponse object. A response owns its
+   *  buffers and cannot be copied, only moved:
+   *  \code
+   *  ParseResponse response = query.send();
+   *  \endcode
+   */
+  ParseResponse(ParseResponse&& other);
+  ParseResponse(const ParseResponse& other) = delete;
+
+  /*! \fn ParseResponse& operator=(ParseResponse&& other)
+   *  \brief close this response and take over other.
+   */
+  ParseResponse& operator=(ParseResponse&& other);
+
   /*! \fn ParseResponse()
    *  \brief Destructor of ParseResponse object
    */
@@ -81,14 +189,180 @@ public:
    *
    *  \param buffer - char array buffer
    *  \param size - size of buffer
-   *                NOTE: if buffer is not set, a default size of 128
-   *                will be initialized.
+   *                NOTE(Yun only): if buffer is not set, a default size
+   *                of 128 will be initialized.
+   *                NOTE2(Zero and ESP8266): if buffer is not set, a pooled
+   *                buffer of PARSE_RESPONSE_BUFFER_SIZE - 64 bytes is used,
+   *                256 by default, see ParseConfig.h. It grows with the body
+   *                up to PARSE_RESPONSE_MAX_SIZE bytes. The customer buffer
+   *                never grows, see isTruncated().
    */
   void setBuffer(char* buffer, int size);
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn bool ready()
+   *  \brief check whether a request started with ParseClient::beginRequest()
+   *  has completed.
+   *
+   *  The response is read in the background by Parse.poll(). Once ready() is
+   *  true, the getters can be used without blocking.
+   *
+   *  \result true if the whole response has been received or the request failed
+   */
+  bool ready();
+
+  /*! \fn bool want(const char* key, int* value)
+   *  \brief store the value of key in value while the response is read,
+   *  instead of keeping the response body.
+   *
+   *  Choose the keys before the response is read, then read it with
+   *  readWanted() or, for beginRequest(), Parse.poll(). Only the chosen values
+   *  are kept, so the body can be far larger than the response buffer:
+   *  \code
+   *  double temperature = 0;
+   *  char name[32] = "";
+   *  ParseResponse response = get.send();
+   *  response.want("temperature", &temperature);
+   *  response.want("name", name, sizeof(name));
+   *  response.readWanted();
+   *  \endcode
+   *  The other getters and getJSONBody() do not see the body of such a
+   *  response. A variable whose key is not in the response is left unchanged.
+   *
+   *  \param key - a top-level key of the response, must stay valid until read
+   *  \param value - where to store the value
+   *  \result false if too many keys were chosen
+   */
+  bool want(const char* key, int* value);
+
+  /*! \fn bool want(const char* key, long long* value)
+   *  \brief see want(const char* key, int* value).
+   */
+  bool want(const char* key, long long* value);
+
+  /*! \fn bool want(const char* key, double* value)
+   *  \brief see want(const char* key, int* value).
+   */
+  bool want(const char* key, double* value);
+
+  /*! \fn bool want(const char* key, bool* value)
+   *  \brief see want(const char* key, int* value).
+   */
+  bool want(const char* key, bool* value);
+
+  /*! \fn bool want(const char* key, char* value, int size)
+   *  \brief see want(const char* key, int* value). The value is stored as
+   *  getString() returns it, cut off to fit size.
+   */
+  bool want(const char* key, char* value, int size);
+
+  /*! \fn bool readWanted()
+   *  \brief read the response, storing the values chosen with want().
+   *
+   *  \result true if every chosen key was found
+   */
+  bool readWanted();
+
+  /*! \fn void setStopWhenFound(bool stop)
+   *  \brief stop reading the response as soon as every key chosen with want()
+   *  has been found, instead of reading the body to the end.
+   *
+   *  With Parse.setKeepAlive(true) and a response that declares its length,
+   *  the rest of the body is skipped when the next response is read and the
+   *  connection is reused. Otherwise the connection is closed at once.
+   *
+   *  \param stop - true to stop early
+   */
+  void setStopWhenFound(bool stop);
+
+  /*! \fn bool writeTo(Print& sink)
+   *  \brief write the body of the response to sink while it is read, e.g. to
+   *  a file on an SD card or to a serial port, instead of keeping it.
+   *
+   *  The body is passed on as it arrives, with the chunked encoding removed,
+   *  so it can be of any size:
+   *  \code
+   *  File file = SD.open("config.json", FILE_WRITE);
+   *  ParseResponse response = Parse.sendRequest("GET", "/1/config", "", "");
+   *  response.writeTo(file);
+   *  file.close();
+   *  \endcode
+   *  Call it instead of the getters, which do not see the body of such a
+   *  response.
+   *
+   *  \param sink - where to write the body
+   *  \result true if the whole body was received
+   */
+  bool writeTo(Print& sink);
+
+  /*! \fn bool writeTo(ParseBodyCallback callback)
+   *  \brief see writeTo(Print& sink). callback is called with each piece of
+   *  the body as it arrives.
+   */
+  bool writeTo(ParseBodyCallback callback);
+
+  /*! \fn int getHttpStatus()
+   *  \brief get the HTTP status code of the response, e.g. 200 or 404.
+   *
+   *  Only the status line and headers are read, the body is left for the
+   *  other getters.
+   *
+   *  \result the status code, 0 if no response was received
+   */
+  int getHttpStatus();
+
+  /*! \fn long getRetryAfter()
+   *  \brief get the Retry-After header of the response, sent with 429 and 503.
+   *
+   *  \result seconds to wait before retrying, -1 if not sent
+   */
+  long getRetryAfter();
+
+  /*! \fn const char* getDate()
+   *  \brief get the Date header of the response, the time on the server.
+   *
+   *  \result the date, e.g. "Tue, 15 Nov 1994 08:12:31 GMT", or "" if not sent
+   */
+  const char* getDate();
+
+  /*! \fn bool isTruncated()
+   *  \brief whether the body did not fit in the buffer and was cut short.
+   *
+   *  After nextObject(), whether fields of the current object were dropped
+   *  because they did not fit or were nested deeper than PARSE_JSON_MAX_DEPTH.
+   *  The getters then only see the other fields.
+   *
+   *  \result true if data was dropped
+   */
+  bool isTruncated();
+
+  /*! \brief getErrorCode() of a request put in the offline queue. */
+  const static int ERROR_QUEUED = -2;
+
+  /*! \brief getErrorCode() when no response arrived, Parse's ConnectionFailed. */
+  const static int ERROR_CONNECTION_FAILED = 100;
+
+  /*! \fn bool isQueued()
+   *  \brief whether the request was put in the offline queue instead of sent.
+   *
+   *  NOTE(Zero only): see ParseClient::setOfflineQueue(). The response is
+   *  finished at once, getHttpStatus() returns 0 and getErrorCode() returns
+   *  ERROR_QUEUED.
+   *
+   *  \result true if the request was queued
+   */
+  bool isQueued();
+#endif
+
   /*! \fn int getErrorCode()
    *  \brief get the "error" field in the response.
    *
+   *  NOTE(Zero only): for a 2xx response, 0 is returned from the status line
+   *        and the body is not read. A queued request returns ERROR_QUEUED,
+   *        see isQueued(), and one that got no response returns
+   *        ERROR_CONNECTION_FAILED. A 4xx or 5xx response whose body has no
+   *        "code", e.g. because want() or writeTo() consumed it,
+   *        returns the HTTP status.
    *  \result error_code when error happens, 0 when there is no error
    */
   int getErrorCode();
@@ -96,11 +370,26 @@ public:
   /*! \fn int getInt(const char* key)
    *  \brief get the integer value in the response by key
    *
+   *  NOTE(Zero only): key can also be a path into nested objects and arrays,
+   *        for this getter and the ones below:
+   *  \code
+   *  double latitude = response.getDouble("location.latitude");
+   *  const char* name = response.getString("results[3].name");
+   *  \endcode
+   *        The path is resolved in place, without copying nested values.
    *  \param key - key
    *  \result the value
    */
   int getInt(const char* key);
 
+  /*! \fn long long getLong(const char* key)
+   *  \brief get the 64-bit integer value in the response by key
+   *
+   *  \param key - key
+   *  \result the value
+   */
+  long long getLong(const char* key);
+
   /*! \fn double getDouble(const char* key)
    *  \brief get the double value in the response by key.
    *
@@ -125,6 +414,26 @@ public:
    */
   const char* getString(const char* key);
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn ParseStringView getStringView(const char* key)
+   *  \brief get a value in the response by key without copying it.
+   *
+   *  Unlike getString(), the value is not cut off at 64 characters and is not
+   *  overwritten by the next call, so several values can be held at once:
+   *  \code
+   *  ParseStringView name = response.getStringView("name");
+   *  ParseStringView city = response.getStringView("city");
+   *  Serial.println(name);
+   *  \endcode
+   *  The view points into the response buffer and is valid until the next
+   *  nextObject() or close().
+   *
+   *  \param key - key
+   *  \result the value, or an empty view if key is not found (see exists())
+   */
+  ParseStringView getStringView(const char* key);
+#endif
+
   /*! \fn const char* getJSONBody()
    *  \brief get the complete json value of response.
    *
@@ -133,7 +442,8 @@ public:
   const char* getJSONBody();
 
   /*! \fn bool nextObject()
-   *  \brief ParseQuery ONLY: iterate to next object in query result
+   *  \brief ParseQuery and ParseBatch ONLY: iterate to next object in query result,
+   *  or to the result of the next request in a batch
    *
    *  it has to be called before any object opreation(getInt/String/Double)
    *  including the first object
@@ -142,6 +452,110 @@ public:
    */
   bool nextObject();
 
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+  /*! \fn int forEachObject(ParseObjectCallback callback)
+   *  \brief ParseQuery and ParseBatch ONLY: call callback with each object of
+   *  the result, as it is read from the connection.
+   *  \code
+   *  bool printTemperature(ParseObjectView& object) {
+   *    Serial.println(object.getDouble("temperature"));
+   *    return true;
+   *  }
+   *  ...
+   *  response.forEachObject(printTemperature);
+   *  \endcode
+   *  Only one object is held at a time, so any number of objects takes the
+   *  same memory. A field too large for the buffer is left out of its object,
+   *  see isTruncated().
+   *
+   *  \param callback - called with each object, returns false to stop
+   *  \result the number of objects passed to callback
+   */
+  int forEachObject(ParseObjectCallback callback);
+
+  /*! \fn bool nextObject(T& object)
+   *  \brief ParseQuery ONLY: iterate to the next object in the query result
+   *  and store its fields in the members of object, as described by
+   *  PARSE_FIELDS(T, ...):
+   *  \code
+   *  Reading reading;
+   *  while (response.nextObject(reading)) {
+   *    Serial.println(reading.temperature);
+   *  }
+   *  \endcode
+   *  The object is decoded as it is read from the connection, without being
+   *  kept in the response buffer, so the getters do not see it. A member whose
+   *  key is not in the object is set to 0 or "". Calling count() first reads
+   *  the first object into the response buffer, see readColumns().
+   *
+   *  \param object - where to store the fields
+   *  \result true if successfully iterate to next object
+   *           false if there is no more object
+   */
+  template <class T>
+  bool nextObject(T& object) {
+    int fieldCount;
+    const ParseJsonExtractor::Field* fields = parseFields(&object, &fieldCount);
+    return nextFields(fields, fieldCount, &object);
+  }
+
+  /*! \fn bool addColumn(const char* key, float* values)
+   *  \brief ParseQuery ONLY: choose a key whose values are stored in values,
+   *  one element per object, by readColumns().
+   *
+   *  \param key - a top-level key of the objects, must stay valid until read
+   *  \param values - an array with an element for each object to read
+   *  \result false if too many keys were chosen, see want()
+   */
+  bool addColumn(const char* key, float* values);
+
+  /*! \fn bool addColumn(const char* key, double* values)
+   *  \brief see addColumn(const char* key, float* values).
+   */
+  bool addColumn(const char* key, double* values);
+
+  /*! \fn bool addColumn(const char* key, int* values)
+   *  \brief see addColumn(const char* key, float* values).
+   */
+  bool addColumn(const char* key, int* values);
+
+  /*! \fn bool addColumn(const char* key, unsigned* values)
+   *  \brief see addColumn(const char* key, float* values).
+   */
+  bool addColumn(const char* key, unsigned* values);
+
+  /*! \fn bool addColumn(const char* key, long* values)
+   *  \brief see addColumn(const char* key, float* values).
+   */
+  bool addColumn(const char* key, long* values);
+
+  /*! \fn bool addColumn(const char* key, unsigned long* values)
+   *  \brief see addColumn(const char* key, float* values). Also for uint32_t.
+   */
+  bool addColumn(const char* key, unsigned long* values);
+
+  /*! \fn int readColumns(int maxRows)
+   *  \brief ParseQuery ONLY: read up to maxRows objects of the query result,
+   *  storing the values of the keys chosen with addColumn() in their arrays:
+   *  \code
+   *  float temperatures[100];
+   *  uint32_t times[100];
+   *  response.addColumn("temperature", temperatures);
+   *  response.addColumn("time", times);
+   *  int rows = response.readColumns(100);
+   *  \endcode
+   *  The objects are decoded as they are read from the connection and are not
+   *  kept. An element whose key is not in its object is set to 0. The chosen
+   *  keys are forgotten afterwards. Calling count() first reads the first
+   *  object into the response buffer, where a field that does not fit is
+   *  dropped, see isTruncated().
+   *
+   *  \param maxRows - number of elements of the arrays
+   *  \result the number of objects read
+   */
+  int readColumns(int maxRows);
+#endif
+
   /*! \fn int count()
    *  \brief ParseQuery ONLY: get the count of the objects in query results
    *
@@ -150,7 +564,8 @@ public:
    *  NOTE2(Zero only): the returned count is approximation of the number of
    *        returned objects. If the server sends results multi-chunked, the
    *        count is an approximation of the objects in the first chunk
-   *        (usually 4K-16K)
+   *        (usually 4K-16K). For an exact count, send the query with
+   *        ParseQuery::countOnly().
    *  \result number of objects in the result
    */
   int count();
@@ -164,6 +579,7 @@ public:
   void close();
 
   friend class ParseClient;
+  friend class ParseBatch;
 };
 
 #endif
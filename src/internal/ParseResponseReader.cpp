@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#if defined (ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_ESP8266)
+
+#include "ParseResponseReader.h"
+
+ParseResponseReader::ParseResponseReader(ConnectionClient& in) :
+  in(in), pos(0), end(0), skipLeft(0) {
+}
+
+bool ParseResponseReader::fill() {
+  // Take everything the client has, up to the size of the buffer, in one read.
+  int n = in.available();
+  if (n <= 0)
+    return false;
+  if (n > (int)sizeof(buffer))
+    n = sizeof(buffer);
+  n = in.read((uint8_t*)buffer, n);
+  pos = 0;
+  end = (n > 0) ? n : 0;
+  return end > 0;
+}
+
+int ParseResponseReader::available() {
+  // The client may hold fewer bytes than are left to skip, so skip what has
+  // arrived first. Otherwise the bytes after the skip never show.
+  if (skipLeft)
+    ready();
+  long n = (end - pos) + in.available() - skipLeft;
+  return (n > 0) ? n : 0;
+}
+
+bool ParseResponseReader::ready() {
+  for (;;) {
+    if (pos == end && !fill())
+      return false;
+    if (!skipLeft)
+      return true;
+    int n = (skipLeft < end - pos) ? skipLeft : end - pos;
+    pos += n;
+    skipLeft -= n;
+  }
+}
+
+int ParseResponseReader::read() {
+  if (!ready())
+    return -1;
+  return (unsigned char)buffer[pos++];
+}
+
+int ParseResponseReader::read(const char** data, int max) {
+  if (!ready())
+    return 0;
+  int n = (max < end - pos) ? max : end - pos;
+  *data = buffer + pos;
+  pos += n;
+  return n;
+}
+
+void ParseResponseReader::skip(long n) {
+  skipLeft += n;
+}
+
+void ParseResponseReader::clear() {
+  pos = 0;
+  end = 0;
+  skipLeft = 0;
+}
+
+#endif
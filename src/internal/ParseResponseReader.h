@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseResponseReader_h
+#define ParseResponseReader_h
+
+#include "ConnectionClient.h"
+
+/*! \file ParseResponseReader.h
+ *  \brief ParseResponseReader object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseResponseReader
+ *  \brief Reads a connection in blocks and hands the bytes out one at a time.
+ *
+ *  Each read() of the client goes through the SSL layer, so the response
+ *  parsers take their bytes from here instead of reading the client byte by
+ *  byte. The reader belongs to the connection, not to a response: bytes read
+ *  ahead are kept for the next response on a persistent connection.
+ */
+class ParseResponseReader {
+private:
+  ConnectionClient& in;
+  char buffer[1024];
+  int pos;
+  int end;
+  long skipLeft;
+
+  bool fill();
+  bool ready();
+
+public:
+  /*! \fn ParseResponseReader(ConnectionClient& in)
+   *  \brief Constructor of ParseResponseReader object
+   *
+   *  \param in - the connection to read from
+   */
+  ParseResponseReader(ConnectionClient& in);
+
+  /*! \fn int available()
+   *  \brief number of bytes that can be read without waiting.
+   */
+  int available();
+
+  /*! \fn int read()
+   *  \brief read one byte.
+   *
+   *  \result the byte, or -1 if none has arrived yet
+   */
+  int read();
+
+  /*! \fn int read(const char** data, int max)
+   *  \brief read up to max bytes without copying them.
+   *
+   *  \param data - set to the bytes, valid until the next read
+   *  \param max - most bytes to read
+   *  \result number of bytes read, 0 if none has arrived yet
+   */
+  int read(const char** data, int max);
+
+  /*! \fn void skip(long n)
+   *  \brief drop the next n bytes as they arrive, the unread rest of a response.
+   *
+   *  \param n - number of bytes to drop
+   */
+  void skip(long n);
+
+  /*! \fn void clear()
+   *  \brief drop the bytes read ahead, when the connection is closed.
+   */
+  void clear();
+};
+
+#endif
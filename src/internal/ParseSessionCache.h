@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef ParseSessionCache_h
+#define ParseSessionCache_h
+
+#include "ConnectionClient.h"
+
+#if defined(ARDUINO_ARCH_ESP8266)
+
+/*! \file ParseSessionCache.h
+ *  \brief ParseSessionCache object for the ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseSessionCache
+ *  \brief Keeps the last SSL session of each host for abbreviated handshakes.
+ *  This object is owned by ParseClient and shared by all its connections.
+ */
+class ParseSessionCache {
+private:
+  const static int CACHE_SIZE = 2; // API server and push server
+  const static int HOST_MAX_LEN = 100; // SERVER_URL_MAX_LEN
+
+  struct Entry {
+    char host[HOST_MAX_LEN];
+    BearSSL::Session session;
+    unsigned long lastUsed;
+  };
+
+  Entry entries[CACHE_SIZE];
+  unsigned long hits;
+  unsigned long misses;
+
+  Entry* entryFor(const char* host);
+
+public:
+  /*! \fn ParseSessionCache()
+   *  \brief Constructor of ParseSessionCache object
+   */
+  ParseSessionCache();
+
+  /*! \fn bool connect(ConnectionClient& client, const char* host, unsigned short port)
+   *  \brief Connect the client to host, resuming the cached session if there is one.
+   *
+   *  \param client - the client to connect
+   *  \param host - server host name
+   *  \param port - server port
+   *  \result true if connected
+   */
+  bool connect(ConnectionClient& client, const char* host, unsigned short port);
+
+  /*! \fn unsigned long getHits()
+   *  \brief number of connections that resumed a cached session.
+   */
+  unsigned long getHits();
+
+  /*! \fn unsigned long getMisses()
+   *  \brief number of connections that needed a full handshake.
+   */
+  unsigned long getMisses();
+
+  /*! \fn void clear()
+   *  \brief forget all cached sessions.
+   */
+  void clear();
+};
+
+#endif // ARDUINO_ARCH_ESP8266
+
+#endif
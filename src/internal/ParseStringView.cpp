@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "ParseStringView.h"
+
+ParseStringView::ParseStringView() : start(NULL), size(0), escaped(false) {
+}
+
+ParseStringView::ParseStringView(const char* json, int length) : start(json), size(length), escaped(false) {
+  if (length >= 2 && json[0] == '\"') {
+    ++start;
+    size -= 2;
+    escaped = memchr(start, '\\', size) != NULL;
+  }
+}
+
+int ParseStringView::decode(const char*& p, const char* end, char* out) {
+  // Decodes the character at p into out, at most 3 bytes, and moves p past it.
+  if (*p != '\\' || p + 1 == end) {
+    *out = *p++;
+    return 1;
+  }
+  ++p;
+  char c = *p++;
+  switch (c) {
+    case 'b': *out = '\b'; return 1;
+    case 'f': *out = '\f'; return 1;
+    case 'n': *out = '\n'; return 1;
+    case 'r': *out = '\r'; return 1;
+    case 't': *out = '\t'; return 1;
+    case 'u': break;
+    default: *out = c; return 1;
+  }
+
+  unsigned int code = 0;
+  for (int i = 0; i < 4 && p < end && isxdigit(*p); ++i, ++p) {
+    code = code << 4 | (isdigit(*p) ? *p - '0' : (*p | 0x20) - 'a' + 10);
+  }
+  // UTF-8; surrogate pairs are left as two separate characters.
+  if (code < 0x80) {
+    out[0] = code;
+    return 1;
+  } else if (code < 0x800) {
+    out[0] = 0xC0 | code >> 6;
+    out[1] = 0x80 | (code & 0x3F);
+    return 2;
+  }
+  out[0] = 0xE0 | code >> 12;
+  out[1] = 0x80 | (code >> 6 & 0x3F);
+  out[2] = 0x80 | (code & 0x3F);
+  return 3;
+}
+
+int ParseStringView::next(const char*& p, const char* end, char* out) const {
+  // Only strings are decoded; objects and arrays keep their escapes.
+  if (escaped)
+    return decode(p, end, out);
+  *out = *p++;
+  return 1;
+}
+
+bool ParseStringView::exists() const {
+  return start != NULL;
+}
+
+const char* ParseStringView::data() const {
+  return start;
+}
+
+int ParseStringView::length() const {
+  return size;
+}
+
+int ParseStringView::copyTo(char* buffer, int size) const {
+  if (!buffer || size <= 0)
+    return 0;
+  int n = 0;
+  const char* p = start;
+  const char* end = start + this->size;
+  char c[3];
+  while (p < end) {
+    int len = next(p, end, c);
+    if (n + len > size - 1)
+      break;
+    memcpy(buffer + n, c, len);
+    n += len;
+  }
+  buffer[n] = 0;
+  return n;
+}
+
+bool ParseStringView::equals(const char* s) const {
+  if (!start || !s)
+    return false;
+  if (!escaped)
+    return !strncmp(start, s, size) && !s[size];
+
+  const char* p = start;
+  const char* end = start + size;
+  char c[3];
+  while (p < end) {
+    int len = decode(p, end, c);
+    if (strncmp(s, c, len))
+      return false;
+    s += len;
+  }
+  return !*s;
+}
+
+String ParseStringView::toString() const {
+  String value;
+  value.reserve(size);
+  const char* p = start;
+  const char* end = start + size;
+  char c[4];
+  while (p < end) {
+    int len = next(p, end, c);
+    c[len] = 0;
+    value += c;
+  }
+  return value;
+}
+
+size_t ParseStringView::printTo(Print& out) const {
+  if (!escaped)
+    return out.write((const uint8_t*)start, size);
+  size_t written = 0;
+  const char* p = start;
+  const char* end = start + size;
+  char c[3];
+  while (p < end) {
+    int len = decode(p, end, c);
+    written += out.write((const uint8_t*)c, len);
+  }
+  return written;
+}
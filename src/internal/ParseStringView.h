@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef ParseStringView_h
+#define ParseStringView_h
+
+#include <Arduino.h>
+
+/*! \file ParseStringView.h
+ *  \brief ParseStringView object for the Zero and ESP8266
+ *  include Parse.h, not this file
+ */
+
+/*! \class ParseStringView
+ *  \brief A value in a response, read in place.
+ *
+ *  The view points into the response buffer and stays valid until the buffer
+ *  changes, i.e. until the next nextObject() or close(). String escapes are
+ *  decoded only when the value is copied, compared or printed.
+ */
+class ParseStringView : public Printable {
+private:
+  const char* start;
+  int size;
+  bool escaped;
+
+  static int decode(const char*& p, const char* end, char* out);
+  int next(const char*& p, const char* end, char* out) const;
+
+public:
+  /*! \fn ParseStringView()
+   *  \brief Constructor of an empty ParseStringView, for a value that was not found
+   */
+  ParseStringView();
+
+  /*! \fn ParseStringView(const char* json, int length)
+   *  \brief Constructor of ParseStringView object
+   *
+   *  \param json - a JSON value, a string in quotes or any other value
+   *  \param length - length of the value
+   */
+  ParseStringView(const char* json, int length);
+
+  /*! \fn bool exists() const
+   *  \brief whether the value was found.
+   */
+  bool exists() const;
+
+  /*! \fn const char* data() const
+   *  \brief the value as it is in the response, not NUL terminated and with
+   *  string escapes not decoded.
+   */
+  const char* data() const;
+
+  /*! \fn int length() const
+   *  \brief length of data().
+   */
+  int length() const;
+
+  /*! \fn int copyTo(char* buffer, int size) const
+   *  \brief copy the decoded value into buffer and NUL terminate it.
+   *
+   *  \param buffer - buffer to copy to
+   *  \param size - size of buffer
+   *  \result number of characters copied, without the terminating NUL
+   */
+  int copyTo(char* buffer, int size) const;
+
+  /*! \fn bool equals(const char* s) const
+   *  \brief compare the decoded value to s.
+   */
+  bool equals(const char* s) const;
+
+  /*! \fn String toString() const
+   *  \brief the decoded value as a String.
+   */
+  String toString() const;
+
+  virtual size_t printTo(Print& p) const;
+};
+
+#endif
@@ -26,6 +26,13 @@ ParseTrackEvent::ParseTrackEvent() : ParseObjectCreate() {
 }
 
 void ParseTrackEvent::setEventName(const char* eventName) {
-  httpPath += "/events/";
+  // The path already starts with a slash, see ParseRequest().
+  httpPath += "events/";
   httpPath += eventName;
 }
+
+#if defined (ARDUINO_SAMD_ZERO)
+bool ParseTrackEvent::sendLater() {
+  return ParseObjectCreate::sendLater();
+}
+#endif
@@ -45,6 +45,15 @@ public:
    *  \param eventName event name.
    */
   void setEventName(const char* eventName);
+
+#if defined (ARDUINO_SAMD_ZERO)
+  /*! \fn bool sendLater() override
+   *  \brief add the event to the offline queue instead of sending it.
+   *
+   *  \result false if the queue is full
+   */
+  bool sendLater();
+#endif
 };
 
 #endif
@@ -32,29 +32,26 @@
  */
 class ParseUtils {
 public:
-  /*! \fn static int getStringFromJSON(const char* data, const char *key, char* value, int size)
-   *  \brief A very lightweight JSON parser to get the string value by key
+  /*! \fn static const char* findValueInJSON(const char* data, const char *key)
+   *  \brief A very lightweight JSON parser to find the value of a key
    *
    *  \param data - JSON string to parse
    *  \param key - key to find
-   *  \param value - returned value (always as string) or NULL if just to check values'presence
-   *  \param size - size of the return buffer
-   *  \result 1 if found 0 otherwise
+   *  \result start of the value, or NULL if not found
    */
-  static int getStringFromJSON(const char* data, const char *key, char* value, int size) {
+  static const char* findValueInJSON(const char* data, const char *key) {
     const char* found = NULL;
     int inString = 0;
-    int json = 0;
-    int backslash = 0;
-    int endWithQuote = 1;
-    int keyLen = strlen(key);
-    int escape = 0;
+    int keyLen;
     int jsonLevel = 0;
     if (!data || !key || !*key)
-         return 0;
+         return NULL;
+    keyLen = strlen(key);
+    const char* start = data;
 
     for (found = data; *found; ++found) {
-      if (strncmp(found, key, keyLen)) {
+      // The key has to start right after a quote, not just end like one.
+      if (strncmp(found, key, keyLen) || found == start || found[-1] != '\"') {
         switch (*found) {
           case '\"':
           inString = 1 - inString;
@@ -77,7 +74,7 @@ public:
             --jsonLevel;
             if (jsonLevel < 0) {
               // Quit on malformed json
-              return 0;
+              return NULL;
             }
           }
           break;
@@ -99,18 +96,36 @@ public:
         }
         ++found;
         for (; *found == ' ' || *found == '\t'; ++found);
-        if (*found == '{' || *found == '[') {
-          json = 1;
-          endWithQuote = 0;
-        } else {
-          if (*found != '\"')
-            endWithQuote = 0;
-        }
-        break;
+        return *found ? found : NULL;
       }
     }
-    if (!*found)
+    return NULL;
+  }
+
+  /*! \fn static int getStringFromJSON(const char* data, const char *key, char* value, int size)
+   *  \brief A very lightweight JSON parser to get the string value by key
+   *
+   *  \param data - JSON string to parse
+   *  \param key - key to find
+   *  \param value - returned value (always as string) or NULL if just to check values'presence
+   *  \param size - size of the return buffer
+   *  \result 1 if found 0 otherwise
+   */
+  static int getStringFromJSON(const char* data, const char *key, char* value, int size) {
+    const char* found = findValueInJSON(data, key);
+    int inString = 0;
+    int json = 0;
+    int backslash = 0;
+    int endWithQuote = 1;
+    int jsonLevel = 0;
+    if (!found)
       return 0;
+    if (*found == '{' || *found == '[') {
+      json = 1;
+      endWithQuote = 0;
+    } else if (*found != '\"') {
+      endWithQuote = 0;
+    }
     if (!value)
       return 1;
     if (endWithQuote)
@@ -173,6 +188,55 @@ public:
     return 1;
   }
 
+  /*! \fn static long long parseLong(const char* value)
+   *  \brief parse the integer at the start of a JSON value in place.
+   *
+   * \param value - the value, a number or a number in quotes
+   * \result the integer, 0 if the value is not a number
+   */
+  static long long parseLong(const char* value) {
+    if (!value)
+      return 0;
+    if (*value == '\"')
+      ++value;
+    bool negative = *value == '-';
+    if (negative || *value == '+')
+      ++value;
+    unsigned long long v = 0;
+    for (; *value >= '0' && *value <= '9'; ++value) {
+      v = v * 10 + (*value - '0');
+    }
+    return negative ? -(long long)v : (long long)v;
+  }
+
+  /*! \fn static double parseDouble(const char* value)
+   *  \brief parse the number at the start of a JSON value in place.
+   *
+   * \param value - the value, a number or a number in quotes, exponent allowed
+   * \result the number, .0 if the value is not a number
+   */
+  static double parseDouble(const char* value) {
+    if (!value)
+      return .0;
+    if (*value == '\"')
+      ++value;
+    return strtod(value, NULL);
+  }
+
+  /*! \fn static bool parseBoolean(const char* value)
+   *  \brief parse the boolean at the start of a JSON value in place.
+   *
+   * \param value - the value, true or false, possibly in quotes
+   * \result the boolean, false if the value is not true
+   */
+  static bool parseBoolean(const char* value) {
+    if (!value)
+      return false;
+    if (*value == '\"')
+      ++value;
+    return !strncmp(value, "true", 4) && !isalnum(value[4]);
+  }
+
   /*! \fn static int getIntFromJSON(const char* data, const char* key)
    *  \brief A very lightweight JSON parser to get the integer value by key
    *
@@ -181,16 +245,18 @@ public:
    * \param value - returned integer value, 0 if key not found
    */
   static int getIntFromJSON(const char* data, const char* key) {
-    char* value = new char[10];
-    if (ParseUtils::getStringFromJSON(data, key, value, 10)) {
-      String c = value;
-      int v = c.toInt();
-      delete[] value;
-      return  v;
-    }
+    return parseLong(findValueInJSON(data, key));
+  }
 
-    delete[] value;
-    return 0;
+  /*! \fn static long long getLongFromJSON(const char* data, const char* key)
+   *  \brief A very lightweight JSON parser to get the 64-bit integer value by key
+   *
+   * \param data - JSON string to parse
+   * \param key - key to find
+   * \param value - returned integer value, 0 if key not found
+   */
+  static long long getLongFromJSON(const char* data, const char* key) {
+    return parseLong(findValueInJSON(data, key));
   }
 
   /*! \fn static double getFloatFromJSON(const char* data, const char* key)
@@ -201,19 +267,10 @@ public:
    * \param value - returned double value, .0 if key not found
    */
   static double getFloatFromJSON(const char* data, const char* key) {
-    char* value = new char[10];
-    if (ParseUtils::getStringFromJSON(data, key, value, 10)) {
-      String c = value;
-      double v = c.toFloat();
-      delete[] value;
-      return  v;
-    }
-
-    delete[] value;
-    return .0;
+    return parseDouble(findValueInJSON(data, key));
   }
 
-  /*! \fn static double getFloatFromJSON(const char* data, const char* key)
+  /*! \fn static bool getBooleanFromJSON(const char* data, const char* key)
    *  \brief A very lightweight JSON parser to get the boolean value by key
    *
    * \param data - JSON string to parse
@@ -221,16 +278,7 @@ public:
    * \param value - returned boolean value. false if key not found
    */
   static bool getBooleanFromJSON(const char* data, const char* key) {
-    char* value = new char[10];
-    if (ParseUtils::getStringFromJSON(data, key, value, 10)) {
-      String c = value;
-      bool v = (c == "true")?true:false;
-      delete[] value;
-      return v;
-    }
-
-    delete[] value;
-    return false;
+    return parseBoolean(findValueInJSON(data, key));
   }
 
   static bool isSanitizedString(const String& userData) {
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#if defined (ARDUINO_ARCH_ESP8266)
+
+#include "../ParseSessionCache.h"
+
+ParseSessionCache::ParseSessionCache() {
+  clear();
+}
+
+ParseSessionCache::Entry* ParseSessionCache::entryFor(const char* host) {
+  Entry* oldest = &entries[0];
+  for (int i = 0; i < CACHE_SIZE; ++i) {
+    if (!strncmp(entries[i].host, host, sizeof(entries[i].host)))
+      return &entries[i];
+    if (entries[i].lastUsed < oldest->lastUsed)
+      oldest = &entries[i];
+  }
+
+  // Evict the least recently used host.
+  strncpy(oldest->host, host, sizeof(oldest->host) - 1);
+  oldest->host[sizeof(oldest->host) - 1] = 0;
+  oldest->session = BearSSL::Session();
+  return oldest;
+}
+
+bool ParseSessionCache::connect(ConnectionClient& client, const char* host, unsigned short port) {
+  Entry* entry = entryFor(host);
+  entry->lastUsed = millis();
+
+  // The server keeps the session id when it accepts an abbreviated handshake
+  // and issues a new one after a full handshake.
+  br_ssl_session_parameters* params = entry->session.getSession();
+  unsigned char offeredId[sizeof(params->session_id)];
+  unsigned char offeredLen = params->session_id_len;
+  memcpy(offeredId, params->session_id, sizeof(offeredId));
+
+  client.setSession(&entry->session);
+  if (!client.connect(host, port))
+    return false;
+
+  if (offeredLen && params->session_id_len == offeredLen &&
+      !memcmp(offeredId, params->session_id, offeredLen)) {
+    ++hits;
+  } else {
+    ++misses;
+  }
+  return true;
+}
+
+unsigned long ParseSessionCache::getHits() {
+  return hits;
+}
+
+unsigned long ParseSessionCache::getMisses() {
+  return misses;
+}
+
+void ParseSessionCache::clear() {
+  for (int i = 0; i < CACHE_SIZE; ++i) {
+    entries[i].host[0] = 0;
+    entries[i].session = BearSSL::Session();
+    entries[i].lastUsed = 0;
+  }
+  hits = 0;
+  misses = 0;
+}
+
+#endif // ARDUINO_ARCH_ESP8266
@@ -35,6 +35,28 @@ ParseResponse::ParseResponse(Process* client) {
   this->client = client;
 }
 
+ParseResponse::ParseResponse(ParseResponse&& other) {
+  *this = static_cast<const ParseResponse&>(other);
+  other.forget();
+}
+
+ParseResponse& ParseResponse::operator=(ParseResponse&& other) {
+  if (this != &other) {
+    close();
+    *this = static_cast<const ParseResponse&>(other);
+    other.forget();
+  }
+  return *this;
+}
+
+void ParseResponse::forget() {
+  // The buffers and the process now belong to another response.
+  buf = NULL;
+  tmpBuf = NULL;
+  isUserBuffer = false;
+  client = NULL;
+}
+
 ParseResponse::~ParseResponse() {
   close();
 }
@@ -86,6 +108,11 @@ int ParseResponse::getInt(const char* key) {
   return ParseUtils::getIntFromJSON(buf, key);
 }
 
+long long ParseResponse::getLong(const char* key) {
+  read();
+  return ParseUtils::getLongFromJSON(buf, key);
+}
+
 double ParseResponse::getDouble(const char* key) {
   read();
   return ParseUtils::getFloatFromJSON(buf, key);
@@ -22,6 +22,8 @@
 #if defined (ARDUINO_SAMD_ZERO)
 
 #include "../ParseClient.h"
+#include "../ParseRequestWriter.h"
+#include "../ParseBatch.h"
 #include "../../external/FlashStorage/FlashStorage.h"
 #include <sys/time.h>
 
@@ -33,6 +35,7 @@ const char* USER_AGENT = "arduino-zero.v.1.0.1";
 const char* CLIENT_VERSION = "1.0.3";
 const char* PARSE_PUSH = "push.parse.com";
 const unsigned short SSL_PORT = 443;
+const unsigned long RESPONSE_TIMEOUT = 30000; // same as ParseResponse
 
 struct KeysInternalStorage {
   bool assigned;
@@ -73,13 +76,14 @@ static String createNewInstallationId(void) {
   return String(buff);
 }
 
-static void sendAndEchoToSerial(WiFiClient& client, const char *line) {
-  client.print(line);
+static bool sendAndEchoToSerial(WiFiClient& client, const char *line) {
+  size_t written = client.print(line);
   if (Serial && DEBUG)
     Serial.print(line);
+  return written == strlen(line);
 }
 
-ParseClient::ParseClient() {
+ParseClient::ParseClient() : reader(client), asyncResponse(&client) {
   memset(applicationId, 0, sizeof(applicationId));
   memset(clientKey, 0, sizeof(clientKey));
   memset(installationId, 0, sizeof(installationId));
@@ -87,6 +91,14 @@ ParseClient::ParseClient() {
   memset(lastPushTime, 0, sizeof(lastPushTime));
   lastHeartbeat = 0;
   dataIsDirty = false;
+  keepAlive = false;
+  connectionReusable = false;
+  asyncState = ASYNC_IDLE;
+  asyncBodySent = 0;
+  asyncReused = false;
+  asyncCallback = NULL;
+  offlineQueueEnabled = false;
+  sendingOfflineQueue = false;
 }
 
 ParseClient::~ParseClient() {
@@ -111,6 +123,93 @@ void ParseClient::begin(const char *applicationId, const char *clientKey) {
   restoreKeys();
 }
 
+void ParseClient::setKeepAlive(bool keepAlive) {
+  this->keepAlive = keepAlive;
+  if (!keepAlive) {
+    connectionReusable = false;
+  }
+}
+
+void ParseClient::setOfflineQueue(bool enabled) {
+  offlineQueueEnabled = enabled;
+}
+
+bool ParseClient::queueRequest(const String& httpVerb, const String& httpPath, const String& requestBody) {
+  bool queued = offlineQueue.push(httpVerb, httpPath, requestBody);
+  if (Serial && DEBUG)
+    Serial.println(queued ? "request queued for later" : "offline queue full, request dropped");
+  return queued;
+}
+
+bool ParseClient::queueOffline(const String& httpVerb, const String& httpPath, const String& requestBody) {
+  if (!offlineQueueEnabled || sendingOfflineQueue)
+    return false;
+  // Only writes that can wait: object creates and updates, and events.
+  if (httpVerb != "POST" && httpVerb != "PUT")
+    return false;
+  if (!httpPath.startsWith("/classes/") && !httpPath.startsWith("/events/"))
+    return false;
+  return queueRequest(httpVerb, httpPath, requestBody);
+}
+
+bool ParseClient::sendOfflineQueue() {
+  String httpVerb;
+  String httpPath;
+  String requestBody;
+
+  while (offlineQueue.size() > 0) {
+    ParseBatch batch;
+    for (int pos = offlineQueue.first(); pos >= 0 && batch.size() < ParseBatch::MAX_REQUESTS; pos = offlineQueue.next(pos)) {
+      offlineQueue.get(pos, httpVerb, httpPath, requestBody);
+      batch.addRequest(httpVerb, httpPath, requestBody);
+    }
+
+    sendingOfflineQueue = true;
+    ParseResponse response = batch.send();
+    sendingOfflineQueue = false;
+
+    int status = response.getHttpStatus();
+    if (status == 400) {
+      if (Serial && DEBUG)
+        Serial.println("server rejected queued requests, dropping them");
+      response.close();
+      offlineQueue.drop(batch.size());
+      continue;
+    }
+    if (status < 200 || status >= 300) {
+      response.close();
+      return false;
+    }
+
+    // Requests that fail one by one are reported in the body. They would fail
+    // the same way again, so they are dropped instead of retried.
+    int results = 0;
+    while (results < batch.size() && response.nextObject()) {
+      if (response.getErrorCode()) {
+        if (Serial && DEBUG)
+          Serial.println("server rejected a queued request, dropping it");
+        offlineQueue.drop(1);
+      } else {
+        offlineQueue.remove(1);
+      }
+      ++results;
+    }
+    response.close();
+    // The rest stays queued when the response was cut short.
+    if (results < batch.size())
+      return false;
+  }
+  return true;
+}
+
+int ParseClient::getOfflineQueueSize() {
+  return offlineQueue.size();
+}
+
+unsigned long ParseClient::getOfflineQueueDropped() {
+  return offlineQueue.getDropped();
+}
+
 void ParseClient::setInstallationId(const char *installationId) {
   if (installationId) {
     if (strcmp(this->installationId, installationId))
@@ -183,9 +282,6 @@ ParseResponse ParseClient::sendRequest(const char* httpVerb, const char* httpPat
 }
 
 ParseResponse ParseClient::sendRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams) {
-  char buff[91] = {0};
-  client.stop();
-
   saveKeys();
 
   if (Serial && DEBUG) {
@@ -200,62 +296,265 @@ ParseResponse ParseClient::sendRequest(const String& httpVerb, const String& htt
     Serial.println("\")");
   }
 
+  if (asyncState != ASYNC_IDLE) {
+    if (Serial && DEBUG)
+      Serial.println("aborting request started with beginRequest()");
+    finishAsyncRequest(false);
+  }
+
+  // Queued requests go first so that the server sees writes in order. If they
+  // cannot be sent, neither can this one.
+  bool queued = false;
+  bool flushFailed = false;
+  if (offlineQueueEnabled && !sendingOfflineQueue && offlineQueue.size() > 0) {
+    flushFailed = !sendOfflineQueue();
+    if (flushFailed) {
+      queued = queueOffline(httpVerb, httpPath, requestBody);
+      // Nothing is sent, so a request that could not be queued fails here.
+      client.stop();
+      reader.clear();
+    }
+  }
+
+  // The previous response clears connectionReusable until it has been read
+  // to the end, so a reused connection never carries stale response data.
+  bool reused = !flushFailed && keepAlive && connectionReusable && client.connected();
+  connectionReusable = false;
+
+  bool sent = flushFailed;
+  if (reused) {
+    if (Serial && DEBUG)
+      Serial.println("reusing connection to server");
+    sent = writeRequest(httpVerb, httpPath, requestBody, urlParams);
+    if (sent) {
+      // The server may have dropped the idle connection while the request was
+      // on its way. It then closes without answering, and it is safe to resend.
+      unsigned long start = millis();
+      bool timedOut = false;
+      while (client.connected() && !reader.available()) {
+        if (millis() - start > RESPONSE_TIMEOUT) {
+          // A half-open connection that never answers. The request may have
+          // reached the server, so it fails instead of being sent again.
+          if (Serial && DEBUG)
+            Serial.println("no answer from server");
+          client.stop();
+          reader.clear();
+          timedOut = true;
+          break;
+        }
+        delay(1);
+      }
+      sent = timedOut || reader.available() > 0;
+    }
+    if (!sent && Serial && DEBUG)
+      Serial.println("connection went stale, reconnecting");
+  }
+
+  if (!sent) {
+    if (connect()) {
+      writeRequest(httpVerb, httpPath, requestBody, urlParams);
+    } else {
+      queued = queueOffline(httpVerb, httpPath, requestBody);
+    }
+  }
+  ParseResponse response(queued ? NULL : &client);
+  response.endpoint = ParseBufferPool::endpointHash(httpVerb.c_str(), httpPath.c_str());
+  if (queued)
+    response.markQueued();
+  return response;
+}
+
+bool ParseClient::connect() {
+  client.stop();
+  reader.clear();
+
   int retry = 3;
   bool connected;
-
   while(!(connected = client.connectSSL(PARSE_API, SSL_PORT)) && retry--);
 
-  if (connected) {
-    if (Serial && DEBUG) {
+  if (Serial && DEBUG) {
+    if (connected) {
       Serial.println("connected to server");
       Serial.println(applicationId);
       Serial.println(clientKey);
       Serial.println(installationId);
-    }
-    if (urlParams.length() > 0) {
-        snprintf(buff, sizeof(buff) - 1, "%s %s?%s HTTP/1.1\r\n", httpVerb.c_str(), httpPath.c_str(), urlParams.c_str());
     } else {
-        snprintf(buff, sizeof(buff) - 1, "%s %s HTTP/1.1\r\n", httpVerb.c_str(), httpPath.c_str());
-    }
-    sendAndEchoToSerial(client, buff);
-    snprintf(buff, sizeof(buff) - 1, "Host: %s\r\n",  PARSE_API);
-    sendAndEchoToSerial(client, buff);
-    snprintf(buff, sizeof(buff) - 1, "X-Parse-Client-Version: %s\r\n", CLIENT_VERSION);
-    sendAndEchoToSerial(client, buff);
-    snprintf(buff, sizeof(buff) - 1, "X-Parse-Application-Id: %s\r\n", applicationId);
-    sendAndEchoToSerial(client, buff);
-    snprintf(buff, sizeof(buff) - 1, "X-Parse-Client-Key: %s\r\n", clientKey);
-    sendAndEchoToSerial(client, buff);
-
-    if (strlen(installationId) > 0) {
-      snprintf(buff, sizeof(buff) - 1, "X-Parse-Installation-Id: %s\r\n", installationId);
-      sendAndEchoToSerial(client, buff);
-    }
-    if (strlen(sessionToken) > 0) {
-      snprintf(buff, sizeof(buff) - 1, "X-Parse-Session-Token: %s\r\n", sessionToken);
-      sendAndEchoToSerial(client, buff);
-    }
-    if (requestBody.length() > 0 && httpVerb != "GET") {
-      requestBody;
-      sendAndEchoToSerial(client, "Content-Type: application/json; charset=utf-8\r\n");
-    } else if (urlParams.length() > 0) {
-      sendAndEchoToSerial(client, "Content-Type: html/text\r\n");
-    }
-    if (requestBody.length() > 0 && httpVerb != "GET") {
-      snprintf(buff, sizeof(buff) - 1, "Content-Length: %d\r\n", requestBody.length());
-      sendAndEchoToSerial(client, buff);
-    }
-    sendAndEchoToSerial(client, "Connection: close\r\n");
-    sendAndEchoToSerial(client, "\r\n");
-    if (requestBody.length() > 0) {
-      sendAndEchoToSerial(client, requestBody.c_str());
-    }
-  } else {
-    if (Serial && DEBUG)
       Serial.println("failed to connect to server");
+    }
   }
-  ParseResponse response(&client);
-  return response;
+  return connected;
+}
+
+void ParseClient::printHeaders(Print& out, const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams) {
+  out.print(httpVerb.c_str());
+  out.print(" ");
+  out.print(httpPath.c_str());
+  if (urlParams.length() > 0) {
+    out.print("?");
+    out.print(urlParams.c_str());
+  }
+  out.print(" HTTP/1.1\r\nHost: ");
+  out.print(PARSE_API);
+  out.print("\r\nX-Parse-Client-Version: ");
+  out.print(CLIENT_VERSION);
+  out.print("\r\nX-Parse-Application-Id: ");
+  out.print(applicationId);
+  out.print("\r\nX-Parse-Client-Key: ");
+  out.print(clientKey);
+  out.print("\r\n");
+
+  if (strlen(installationId) > 0) {
+    out.print("X-Parse-Installation-Id: ");
+    out.print(installationId);
+    out.print("\r\n");
+  }
+  if (strlen(sessionToken) > 0) {
+    out.print("X-Parse-Session-Token: ");
+    out.print(sessionToken);
+    out.print("\r\n");
+  }
+  if (requestBody.length() > 0 && httpVerb != "GET") {
+    out.print("Content-Type: application/json; charset=utf-8\r\n");
+    out.print("Content-Length: ");
+    out.print(requestBody.length());
+    out.print("\r\n");
+  } else if (urlParams.length() > 0) {
+    out.print("Content-Type: html/text\r\n");
+  }
+  out.print(keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n");
+}
+
+bool ParseClient::writeRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams) {
+  ParseRequestWriter writer(client, requestBuffer, sizeof(requestBuffer), Serial && DEBUG);
+
+  printHeaders(writer, httpVerb, httpPath, requestBody, urlParams);
+  if (requestBody.length() > 0) {
+    writer.print(requestBody.c_str());
+  }
+  return writer.finish();
+}
+
+ParseResponse* ParseClient::beginRequest(const char* httpVerb, const char* httpPath, const char* requestBody, const char* urlParams, ParseResponseCallback callback) {
+  return beginRequest(String(httpVerb), String(httpPath), String(requestBody), String(urlParams), callback);
+}
+
+ParseResponse* ParseClient::beginRequest(const String& httpVerb, const String& httpPath, const String& requestBody, const String& urlParams, ParseResponseCallback callback) {
+  if (asyncState != ASYNC_IDLE)
+    return NULL;
+
+  saveKeys();
+
+  if (Serial && DEBUG) {
+    Serial.print("beginRequest(\"");
+    Serial.print(httpVerb.c_str());
+    Serial.print("\", \"");
+    Serial.print(httpPath.c_str());
+    Serial.println("\")");
+  }
+
+  asyncVerb = httpVerb;
+  asyncPath = httpPath;
+  asyncBody = requestBody;
+  asyncParams = urlParams;
+  asyncCallback = callback;
+  asyncResponse.reset();
+  asyncResponse.endpoint = ParseBufferPool::endpointHash(httpVerb.c_str(), httpPath.c_str());
+  asyncState = ASYNC_CONNECT;
+  return &asyncResponse;
+}
+
+void ParseClient::poll() {
+  switch (asyncState) {
+    case ASYNC_IDLE:
+      break;
+
+    case ASYNC_CONNECT:
+      asyncReused = keepAlive && connectionReusable && client.connected();
+      connectionReusable = false;
+      if (asyncReused) {
+        if (Serial && DEBUG)
+          Serial.println("reusing connection to server");
+        asyncState = ASYNC_WRITE_HEADERS;
+      } else if (connect()) {
+        asyncState = ASYNC_WRITE_HEADERS;
+      } else {
+        finishAsyncRequest(false);
+      }
+      break;
+
+    case ASYNC_WRITE_HEADERS: {
+      // Send the headers together with as much of the body as fits the buffer.
+      ParseRequestWriter writer(client, requestBuffer, sizeof(requestBuffer), Serial && DEBUG);
+      printHeaders(writer, asyncVerb, asyncPath, asyncBody, asyncParams);
+      asyncBodySent = writer.availableForWrite();
+      if (asyncBodySent > asyncBody.length())
+        asyncBodySent = asyncBody.length();
+      writer.write((const uint8_t*)asyncBody.c_str(), asyncBodySent);
+      if (writer.finish()) {
+        asyncState = ASYNC_WRITE_BODY;
+      } else if (asyncReused) {
+        asyncState = ASYNC_CONNECT;
+      } else {
+        finishAsyncRequest(false);
+      }
+    } break;
+
+    case ASYNC_WRITE_BODY: {
+      // One buffer worth of the remaining body per call.
+      unsigned int length = asyncBody.length() - asyncBodySent;
+      if (length > sizeof(requestBuffer))
+        length = sizeof(requestBuffer);
+      if (length) {
+        const uint8_t* data = (const uint8_t*)asyncBody.c_str() + asyncBodySent;
+        if (client.write(data, length) != length) {
+          finishAsyncRequest(false);
+          break;
+        }
+        if (Serial && DEBUG)
+          Serial.write(data, length);
+        asyncBodySent += length;
+      }
+      if (asyncBodySent == asyncBody.length()) {
+        asyncResponse.lastActivity = millis();
+        asyncState = ASYNC_READ_RESPONSE;
+      }
+    } break;
+
+    case ASYNC_READ_RESPONSE:
+      if (!asyncResponse.readAvailable())
+        break;
+      if (asyncResponse.timedOut) {
+        // The request may have reached the server, so it is not sent again.
+        // The response has already closed the connection.
+        if (Serial && DEBUG)
+          Serial.println("no answer from server");
+        finishAsyncRequest(false);
+        break;
+      }
+      if (asyncReused && !asyncResponse.http.status && !asyncResponse.linePos) {
+        // The server dropped the idle connection before sending a byte, resend.
+        if (Serial && DEBUG)
+          Serial.println("connection went stale, reconnecting");
+        asyncResponse.reset();
+        asyncState = ASYNC_CONNECT;
+        break;
+      }
+      finishAsyncRequest(true);
+      break;
+  }
+}
+
+void ParseClient::finishAsyncRequest(bool complete) {
+  if (!complete && !asyncResponse.ready()) {
+    asyncResponse.finishRead(false); // closes the connection
+  }
+  asyncState = ASYNC_IDLE;
+  asyncVerb = "";
+  asyncPath = "";
+  asyncBody = "";
+  asyncParams = "";
+  if (asyncCallback)
+    asyncCallback(asyncResponse);
 }
 
 bool ParseClient::startPushService() {
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#if defined (ARDUINO_SAMD_ZERO)
+
+#include "../ParseOfflineQueue.h"
+#include "../../external/FlashStorage/FlashStorage.h"
+
+static const uint32_t RECORD_MAGIC = 0x5051;
+static const uint32_t RECORD_SENT = 0;
+static const uint32_t ERASED_WORD = 0xFFFFFFFF;
+
+// Reserve a portion of flash memory for the log, as the Flash() macro does.
+__attribute__((__aligned__(256)))
+static const uint8_t queueStorage[ParseOfflineQueue::QUEUE_SIZE] = { };
+static FlashClass queueFlash(queueStorage, sizeof(queueStorage));
+
+ParseOfflineQueue::ParseOfflineQueue() {
+  loaded = false;
+  writePos = 0;
+  readPos = -1;
+  pending = 0;
+  erased = false;
+  dropped = 0;
+}
+
+uint32_t ParseOfflineQueue::readWord(int pos) {
+  uint32_t word;
+  queueFlash.read(queueStorage + pos, &word, sizeof(word));
+  return word;
+}
+
+int ParseOfflineQueue::recordSize(uint32_t info) {
+  return sizeof(Record) + (((info & 0xFFFF) + 3) & ~3);
+}
+
+void ParseOfflineQueue::program(int pos, const void* data, int size) {
+  // FlashClass writes one page at a time, starting at the given address.
+  const uint8_t* bytes = (const uint8_t*)data;
+  int pageSize = queueFlash.pageSize();
+  while (size > 0) {
+    int length = pageSize - pos % pageSize;
+    if (length > size)
+      length = size;
+    queueFlash.write(queueStorage + pos, bytes, length);
+    pos += length;
+    bytes += length;
+    size -= length;
+  }
+}
+
+void ParseOfflineQueue::readString(int& pos, String& value) {
+  const volatile char* data = (const volatile char*)queueStorage;
+  value = "";
+  while (data[pos]) {
+    value += (char)data[pos++];
+  }
+  ++pos;
+}
+
+void ParseOfflineQueue::reset() {
+  queueFlash.erase(queueStorage, QUEUE_SIZE);
+  writePos = 0;
+  readPos = -1;
+  pending = 0;
+  erased = true;
+}
+
+void ParseOfflineQueue::begin() {
+  loaded = true;
+  writePos = 0;
+  readPos = -1;
+  pending = 0;
+
+  while (writePos + (int)sizeof(Record) <= QUEUE_SIZE) {
+    uint32_t info = readWord(writePos);
+    if (info == ERASED_WORD || (info >> 16) != RECORD_MAGIC ||
+        writePos + recordSize(info) > QUEUE_SIZE)
+      break;
+    if (readWord(writePos + 4) != RECORD_SENT) {
+      if (readPos < 0)
+        readPos = writePos;
+      ++pending;
+    }
+    writePos += recordSize(info);
+  }
+
+  // A reset in the middle of a write leaves data after the last record, and
+  // a fresh upload leaves the region zeroed. Neither can be written over.
+  erased = true;
+  for (int pos = writePos; pos < QUEUE_SIZE && erased; pos += 4) {
+    erased = readWord(pos) == ERASED_WORD;
+  }
+}
+
+bool ParseOfflineQueue::push(const String& httpVerb, const String& httpPath, const String& requestBody) {
+  if (!loaded)
+    begin();
+  int length = httpVerb.length() + httpPath.length() + requestBody.length() + 3;
+  int size = recordSize(length);
+  // Erasing only when the space is needed spares the flash.
+  if (!pending && (!erased || writePos + size > QUEUE_SIZE))
+    reset();
+  if (length > 0xFFFF || !erased || writePos + size > QUEUE_SIZE) {
+    ++dropped;
+    return false;
+  }
+
+  int dataSize = size - sizeof(Record);
+  uint8_t* data = new uint8_t[dataSize];
+  memset(data, 0xFF, dataSize);
+  uint8_t* ptr = data;
+  memcpy(ptr, httpVerb.c_str(), httpVerb.length() + 1);
+  ptr += httpVerb.length() + 1;
+  memcpy(ptr, httpPath.c_str(), httpPath.length() + 1);
+  ptr += httpPath.length() + 1;
+  memcpy(ptr, requestBody.c_str(), requestBody.length() + 1);
+  program(writePos + sizeof(Record), data, dataSize);
+  delete[] data;
+
+  // The header goes in last, so a record cut short by a reset never looks complete.
+  uint32_t info = (RECORD_MAGIC << 16) | length;
+  program(writePos, &info, sizeof(info));
+
+  if (readPos < 0)
+    readPos = writePos;
+  writePos += size;
+  ++pending;
+  return true;
+}
+
+int ParseOfflineQueue::first() {
+  if (!loaded)
+    begin();
+  return readPos;
+}
+
+int ParseOfflineQueue::next(int pos) {
+  pos += recordSize(readWord(pos));
+  while (pos < writePos) {
+    uint32_t info = readWord(pos);
+    if (readWord(pos + 4) != RECORD_SENT)
+      return pos;
+    pos += recordSize(info);
+  }
+  return -1;
+}
+
+void ParseOfflineQueue::get(int pos, String& httpVerb, String& httpPath, String& requestBody) {
+  pos += sizeof(Record);
+  readString(pos, httpVerb);
+  readString(pos, httpPath);
+  readString(pos, requestBody);
+}
+
+void ParseOfflineQueue::remove(int count) {
+  while (count-- > 0 && readPos >= 0) {
+    // Clearing bits needs no erase, so a record is marked sent in place.
+    program(readPos + 4, &RECORD_SENT, sizeof(RECORD_SENT));
+    readPos = next(readPos);
+    --pending;
+  }
+}
+
+void ParseOfflineQueue::drop(int count) {
+  if (count > pending)
+    count = pending;
+  remove(count);
+  dropped += count;
+}
+
+int ParseOfflineQueue::size() {
+  if (!loaded)
+    begin();
+  return pending;
+}
+
+unsigned long ParseOfflineQueue::getDropped() {
+  return dropped;
+}
+
+#endif // ARDUINO_SAMD_ZERO
@@ -39,8 +39,7 @@ void ParsePush::setLookahead(const char *read_data) {
 
 void ParsePush::read() {
     if (buf == NULL) {
-        bufSize = BUFSIZE;
-        buf = new char[bufSize];
+        allocateBody();
     }
 
     if (p == bufSize - 1) {
@@ -59,14 +58,12 @@ void ParsePush::read() {
         if (client->available()) {
             c = client->read();
             if (c == '\n') c = '\0';
-            if (p < bufSize - 1) {
-                *(buf + p) = c;
-                p++;
-            }
+            append(p, c);
             if (c == '\0') break;
         }
     }
     p = 0;
+    jsonIndex.clear();
     char time[41];
     if (ParseUtils::getStringFromJSON(buf, "time", time, sizeof(time))) {
       Parse.saveLastPushTime(time);
@@ -22,33 +22,182 @@
 #if defined (ARDUINO_SAMD_ZERO)
 
 #include "../ParseResponse.h"
+#include "../ParseClient.h"
 #include "../ParseInternal.h"
 
-static const char kHttpOK[] = "HTTP/1.1 200 OK";
 static const char kContentLength[] = "Content-Length:";
-static const char kChunkedEncoding[] = "transfer-encoding: chunked";
-// Fortunately we do not need to support *any* JSON, only the one generated by Parse.
-static const char kResultsStart[] = "{\"results\":[";
-static const int kJsonResponseMaxSize = 256;
+static const char kTransferEncoding[] = "Transfer-Encoding:";
+static const char kConnection[] = "Connection:";
+static const char kRetryAfter[] = "Retry-After:";
+static const char kDate[] = "Date:";
 static const int kQueryTimeout = 5000;
-static const int kBufferSize = 1024;
+static const unsigned long kResponseTimeout = 30000;
 
 // Uncomment following line if you want to debug query response with serial output.
 // #define DEBUG_RESPONSE
 
+// Body of a response that got no buffer, see allocateBody().
+static char noBody[1];
+
+// Hands what is written to a ParseBodyCallback, for writeTo().
+class ParseBodyCallbackPrint : public Print {
+public:
+  ParseBodyCallbackPrint(ParseBodyCallback callback) : callback(callback) {
+  }
+
+  virtual size_t write(uint8_t c) {
+    return write(&c, 1);
+  }
+
+  virtual size_t write(const uint8_t* data, size_t length) {
+    callback((const char*)data, length);
+    return length;
+  }
+
+private:
+  ParseBodyCallback callback;
+};
+
 ParseResponse::ParseResponse(ConnectionClient* client) {
+  block = NULL;
+  blockUsed = 0;
+  grown = NULL;
+  endpoint = 0;
+  buf = NULL;
+  tmpBuf = NULL;
+  isUserBuffer = false;
+  this->client = client;
+  reset();
+}
+
+ParseResponse::ParseResponse(ParseResponse&& other) {
+  *this = static_cast<const ParseResponse&>(other);
+  other.forget();
+}
+
+ParseResponse& ParseResponse::operator=(ParseResponse&& other) {
+  if (this != &other) {
+    close();
+    *this = static_cast<const ParseResponse&>(other);
+    other.forget();
+  }
+  return *this;
+}
+
+void ParseResponse::forget() {
+  // The buffers and the connection now belong to another response.
+  block = NULL;
+  blockUsed = 0;
+  grown = NULL;
   buf = NULL;
   tmpBuf = NULL;
+  isUserBuffer = false;
+  client = NULL;
+  jsonIndex.clear();
+}
+
+char* ParseResponse::allocate(int size) {
+  if (!block) {
+    block = Parse.bufferPool.take();
+    blockUsed = 0;
+  }
+  if (!block || blockUsed + size > ParseBufferPool::BLOCK_SIZE)
+    return NULL;
+  char* memory = block + blockUsed;
+  blockUsed += size;
+  return memory;
+}
+
+void ParseResponse::allocateBody() {
+  isUserBuffer = false;
+  bufSize = BUFSIZE;
+  // Start at the size earlier responses of the endpoint grew to.
+  int size = Parse.bufferPool.sizeFor(endpoint);
+  if (size > bufSize) {
+    bufSize = size;
+    buf = grown = new char[bufSize];
+  } else {
+    buf = allocate(bufSize);
+  }
+  if (!buf) {
+    // Out of static buffers: the body is dropped and reads as empty.
+    buf = noBody;
+    bufSize = sizeof(noBody);
+  }
+  memset(buf, 0, bufSize);
+}
+
+void ParseResponse::append(int& length, char c) {
+  if (length >= bufSize - 1 && !growBody(length)) {
+    truncated = true;
+    return;
+  }
+  buf[length++] = c;
+}
+
+bool ParseResponse::growBody(int length) {
+#ifdef PARSE_STATIC_BUFFERS
+  return false;
+#else
+  if (isUserBuffer || buf == noBody || bufSize >= PARSE_RESPONSE_MAX_SIZE)
+    return false;
+  int size = bufSize * 2;
+  if (size > PARSE_RESPONSE_MAX_SIZE)
+    size = PARSE_RESPONSE_MAX_SIZE;
+  char* bigger = new char[size];
+  memcpy(bigger, buf, length);
+  memset(bigger + length, 0, size - length);
+  delete[] grown;
+  buf = grown = bigger;
+  bufSize = size;
+  return true;
+#endif
+}
+
+bool ParseResponse::isTruncated() {
+  read();
+  return truncated;
+}
+
+bool ParseResponse::isQueued() {
+  return queued;
+}
+
+void ParseResponse::markQueued() {
+  // The request waits in the offline queue, there is no answer to read.
+  queued = true;
+  client = NULL;
+  finishRead(false);
+}
+
+void ParseResponse::reset() {
+  freeBuffer();
+  buf = NULL;
   p = 0;
   resultCount = -1;
   bufSize = 0;
   isUserBuffer = false;
-  isChunked = false;
-  responseLength = 0;
+  responseLength = -1;
   dataDone = false;
-  this->client = client;
-  bufferPos = kBufferSize;
-  lastRead = -1;
+  firstObject = false;
+  isBatch = false;
+  stopWhenFound = false;
+  complete = false;
+  timedOut = false;
+  queued = false;
+  truncated = false;
+  sink = NULL;
+  readState = READ_STATUS;
+  linePos = 0;
+  chunkRemaining = 0;
+  http.status = 0;
+  http.contentLength = -1;
+  http.chunked = false;
+  http.keepAlive = true;
+  http.retryAfter = -1;
+  http.date[0] = 0;
+  lastActivity = millis();
+  extractor.clear();
 }
 
 ParseResponse::~ParseResponse() {
@@ -64,261 +213,483 @@ void ParseResponse::setBuffer(char* buffer, int size) {
   bufSize = size;
   isUserBuffer = true;
   memset(buf, 0, bufSize);
+  jsonIndex.clear();
 }
 
 int ParseResponse::available() {
+  if (!client)
+    return 0;
+  if (client == &Parse.client)
+    return Parse.reader.available();
   return client->available();
 }
 
+int ParseResponse::readInput() {
+  // Responses on the API connection are read in blocks, see ParseResponseReader.
+  if (client == &Parse.client)
+    return Parse.reader.read();
+  return client->available() ? client->read() : -1;
+}
+
 void ParseResponse::read() {
-  if (dataDone)
-    return;
-  if (buf == NULL) {
-    bufSize = BUFSIZE;
-    buf = new char[bufSize];
-    memset(buf, 0, bufSize);
+  while (!readAvailable()) {
+    delay(1);
   }
+}
 
-  if (p == bufSize - 1) {
-    return;
-  }
+bool ParseResponse::ready() {
+  return dataDone;
+}
+
+bool ParseResponse::want(const char* key, int* value) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_INT, value, 0);
+}
+
+bool ParseResponse::want(const char* key, long long* value) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_LONG, value, 0);
+}
 
-  memset(buf + p, 0, bufSize - p);
+bool ParseResponse::want(const char* key, double* value) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_DOUBLE, value, 0);
+}
 
-  char c;
-  int i;
+bool ParseResponse::want(const char* key, bool* value) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_BOOLEAN, value, 0);
+}
 
-  bool data = false;
-  int count = 0;
+bool ParseResponse::want(const char* key, char* value, int size) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_STRING, value, size);
+}
 
-  while (client->connected()) {
-    delay(1);
-    while (client->available()) {
-      c = client->read();
-      if (c != '\r') { // filter out '\r' character
-        if (data) {
-          if (p < bufSize - 1) {
-            *(buf + p) = c;
-            p++;
-          }
-        }
-        // filter out the headers
-        if (c == '\n') count++; else count = 0;
-        if (count >= 2) data = true;
-      }
-    }
-  }
-  dataDone = 1;
+void ParseResponse::setStopWhenFound(bool stop) {
+  stopWhenFound = stop;
 }
 
-void ParseResponse::readLine(char *buff, int sz) {
-  memset(buff, 0, sz);
-#ifdef DEBUG_RESPONSE
-  Serial.print("Read line:");
-#endif
-  for (int i = 0; client->available(); ++i) {
-    char c = client->read();
-    if (c == '\r') {
-      client->read(); // read /n
-      return;
+bool ParseResponse::writeTo(Print& out) {
+  sink = &out;
+  read();
+  sink = NULL;
+  return complete;
+}
+
+bool ParseResponse::writeTo(ParseBodyCallback callback) {
+  ParseBodyCallbackPrint out(callback);
+  return writeTo(out);
+}
+
+bool ParseResponse::readWanted() {
+  read();
+  return extractor.allFound();
+}
+
+bool ParseResponse::readAvailable() {
+  if (dataDone)
+    return true;
+  if (buf == NULL && !sink && !extractor.isActive())
+    allocateBody();
+
+  // Stop at the end of the response, anything after it belongs to the next one.
+  while (readState != READ_DONE) {
+    if (sink && (readState == READ_BODY || readState == READ_CHUNK_DATA) && client == &Parse.client) {
+      if (!writeBlock())
+        break;
+    } else {
+      int c = readInput();
+      if (c < 0)
+        break;
+      consume(c);
     }
-    if (c == '\n') {
-      return;
+    lastActivity = millis();
+    if (stopWhenFound && readState != READ_DONE && extractor.isActive() && extractor.allFound()) {
+      stopReading();
+      break;
     }
-#ifdef DEBUG_RESPONSE
-    Serial.print(c);
-#endif
-    if (i < sz - 1)
-      buff[i] = c;
   }
-#ifdef DEBUG_RESPONSE
-  Serial.println("");
-#endif
+
+  if (readState != READ_DONE) {
+    if (!client->connected()) {
+      // Without Content-Length or chunked encoding the body ends with the connection.
+      finishRead(readState == READ_BODY && responseLength < 0);
+    } else if (millis() - lastActivity > kResponseTimeout) {
+      timedOut = true;
+      finishRead(false);
+    }
+  }
+  return dataDone;
+}
+
+bool ParseResponse::writeBlock() {
+  // Pass the body to the sink straight from the reader's buffer.
+  long left = (readState == READ_BODY) ? responseLength : chunkRemaining;
+  const char* data;
+  int n = Parse.reader.read(&data, (left > 0 && left < 0x7fff) ? left : 0x7fff);
+  if (n <= 0)
+    return false;
+  sink->write((const uint8_t*)data, n);
+  if (readState == READ_CHUNK_DATA) {
+    chunkRemaining -= n;
+    if (chunkRemaining == 0)
+      readState = READ_CHUNK_END;
+  } else if (responseLength > 0) {
+    responseLength -= n;
+    if (responseLength == 0)
+      finishRead(true);
+  }
+  return true;
 }
 
-bool ParseResponse::readJson(char *buff, int sz) {
-  memset(buff, 0, sz);
+void ParseResponse::storeBody(char c) {
+  if (sink) {
+    sink->write((uint8_t)c);
+  } else if (extractor.isActive()) {
+    extractor.feed(c);
+  } else if (c != '\r') { // filter out '\r' character
+    append(p, c);
+  }
+}
 
-  int read_bytes = 0;
+void ParseResponse::consume(char c) {
+  if (decode(c))
+    storeBody(c);
+}
 
-  bool res = readJsonInternal(buff, sz, &read_bytes, '\0');
-  if (!res) {
-#ifdef DEBUG_RESPONSE
-    Serial.print("Failed");
-    Serial.println(buff);
-#endif
+bool ParseResponse::decode(char c) {
+  switch (readState) {
+    case READ_BODY:
+      if (responseLength > 0 && --responseLength == 0)
+        finishRead(true);
+      return true;
+    case READ_CHUNK_DATA:
+      if (--chunkRemaining == 0)
+        readState = READ_CHUNK_END;
+      return true;
+    case READ_DONE:
+      return false;
+    default:
+      // status line, headers and chunk framing are read line by line
+      if (c == '\n') {
+        line[linePos] = 0;
+        linePos = 0;
+        processLine();
+      } else if (c != '\r' && linePos < (int)sizeof(line) - 1) {
+        line[linePos++] = c;
+      }
+      return false;
   }
-  return res;
 }
 
-bool ParseResponse::readJsonInternal(char *buff, int sz, int* read_bytes, char started) {
-  // It is our own JSON, so we can be *very* strict in regars to format.
-  char in_string = '\0';
-  int ch;
-  int i;
+// Header names and values are compared without regard to case.
+static const char* headerValue(const char* line, const char* name, int nameLength) {
+  if (strncasecmp(line, name, nameLength))
+    return NULL;
+  line += nameLength;
+  while (*line == ' ' || *line == '\t')
+    ++line;
+  return line;
+}
 
-  char tmp[32];
+static bool hasToken(const char* value, const char* token) {
+  int length = strlen(token);
+  for (; *value; ++value) {
+    if (!strncasecmp(value, token, length))
+      return true;
+  }
+  return false;
+}
 
-  for (i = 0; ; ++i) {
-    bool skip = false;
-    if ((ch = readChunkedData(kQueryTimeout)) < 0) {
-      *read_bytes = i;
-      return false;
-    }
-    switch (ch) {
-      case '\"':
-      case '\'':
-        if (in_string == ch)
-          in_string = '\0';
-        else if (in_string == '\0')
-          in_string = ch;
-        break;
-      case ',':
-        if (in_string)
-          break;
-        if (!started) {
-          --i; // skip
-          skip = true;
-        }
-        break;
-      case '[':
-      case '{':
-      {
-        if (in_string)
-          break;
-        if (!started) {
-          started = ch;
-          break;
+void ParseResponse::processLine() {
+#ifdef DEBUG_RESPONSE
+  Serial.print("H->");
+  Serial.println(line);
+#endif
+  switch (readState) {
+    case READ_STATUS:
+      // "HTTP/1.1 200 OK"
+      if (strchr(line, ' '))
+        http.status = atoi(strchr(line, ' ') + 1);
+      readState = READ_HEADERS;
+      break;
+    case READ_HEADERS:
+      if (line[0]) {
+        const char* value;
+        if ((value = headerValue(line, kContentLength, sizeof(kContentLength) - 1))) {
+          http.contentLength = responseLength = strtol(value, NULL, 10);
+        } else if ((value = headerValue(line, kTransferEncoding, sizeof(kTransferEncoding) - 1))) {
+          http.chunked = hasToken(value, "chunked");
+        } else if ((value = headerValue(line, kConnection, sizeof(kConnection) - 1))) {
+          http.keepAlive = !hasToken(value, "close");
+        } else if ((value = headerValue(line, kRetryAfter, sizeof(kRetryAfter) - 1))) {
+          // Only the number of seconds, not the HTTP-date form.
+          if (isdigit(*value))
+            http.retryAfter = strtol(value, NULL, 10);
+        } else if ((value = headerValue(line, kDate, sizeof(kDate) - 1))) {
+          strncpy(http.date, value, sizeof(http.date) - 1);
+          http.date[sizeof(http.date) - 1] = 0;
         }
-        int added = 0;
-        if (i < sz)
-          buff[i] = ch;
-        bool success = readJsonInternal(buff + i + 1, sz - i - 1, &added, ch);
-        if (!success)
-          return false;
-        i += added;
-        skip = true;
-      } break;
-      case '}':
-      case ']':
-      {
-        if (in_string)
-          break;
-        if (!started)
-          return false;
-        if ((started == '[' && ch != ']') || (started == '{' && ch != '}'))
-          return false;
-        if (i < sz)
-          buff[i] = ch;
-        *read_bytes = i + 1;
-        return true;
-      } break;
+      } else if (http.chunked) {
+        readState = READ_CHUNK_SIZE;
+      } else if (responseLength == 0 || http.status == 204 || http.status == 304) {
+        finishRead(true);
+      } else {
+        readState = READ_BODY;
+      }
+      break;
+    case READ_CHUNK_SIZE:
+      chunkRemaining = strtol(line, NULL, 16);
+      readState = (chunkRemaining > 0) ? READ_CHUNK_DATA : READ_TRAILER;
+      break;
+    case READ_CHUNK_END:
+      readState = READ_CHUNK_SIZE;
+      break;
+    case READ_TRAILER:
+      if (!line[0])
+        finishRead(true);
+      break;
+    default:
+      break;
+  }
+}
+
+void ParseResponse::finishRead(bool complete) {
+  this->complete = complete;
+  readState = READ_DONE;
+  dataDone = true;
+  releaseConnection(complete);
+}
+
+bool ParseResponse::readHeaders() {
+  // Stop at the end of the headers, the body is left for the reader.
+  while (!dataDone && (readState == READ_STATUS || readState == READ_HEADERS)) {
+    int c = readInput();
+    if (c >= 0) {
+      consume(c);
+      lastActivity = millis();
+    } else if (!client->connected()) {
+      finishRead(false);
+    } else if (millis() - lastActivity > kResponseTimeout) {
+      timedOut = true;
+      finishRead(false);
+    } else {
+      delay(1);
     }
-    if (!skip && i < sz - 1)
-      buff[i] = ch;
   }
+  return http.status != 0;
 }
 
-#ifdef DEBUG_RESPONSE
-void printData(char *d, int sz, int offset) {
-  char t1[32];
-  sprintf(t1,"\r\n%d %04x[->", sz, offset);
-  Serial.print(t1);
-  char tmp[4] = {0};
-  for (int i = 0; i < sz; ++i) {
-    if (d[i] >= 32 && d[i] <= 127)
-      tmp[0] = d[i];
-    else
-      tmp[0] = '?';
-    Serial.print(tmp);
+int ParseResponse::getHttpStatus() {
+  readHeaders();
+  return http.status;
+}
+
+long ParseResponse::getRetryAfter() {
+  readHeaders();
+  return http.retryAfter;
+}
+
+const char* ParseResponse::getDate() {
+  readHeaders();
+  return http.date;
+}
+
+void ParseResponse::stopReading() {
+  // Everything wanted has been found, the rest of the body is not needed.
+  if (readState == READ_BODY && responseLength > 0 && client == &Parse.client) {
+    // Its length is known, so the connection can still be reused once the
+    // rest has been skipped.
+    Parse.reader.skip(responseLength);
+    finishRead(true);
+  } else {
+    finishRead(false);
   }
-  Serial.println("<-]");
 }
-#endif
 
-int ParseResponse::readChunkedData(int timeout) {
+void ParseResponse::releaseConnection(bool complete) {
+  if (client != &Parse.client)
+    return;
+  Parse.connectionReusable = complete && http.keepAlive && Parse.keepAlive;
+  if (!Parse.connectionReusable) {
+    client->stop();
+    Parse.reader.clear();
+  }
+}
 
-  char snum[16];
+bool ParseResponse::readJson() {
+  // It is our own JSON, so we can be *very* strict in regards to format.
+  // Open brackets are kept on a fixed stack rather than by recursion, so a
+  // deeply nested value costs no more call stack than a flat one.
+  // A field that does not fit in the buffer is dropped whole and the rest of
+  // the object is still read, so any object size takes the same memory.
+  // So is a field nested deeper than the stack; its brackets are only counted.
+  char nesting[PARSE_JSON_MAX_DEPTH];
+  int depth = 0;
+  int overflow = 0; // open brackets beyond PARSE_JSON_MAX_DEPTH
+  bool inString = false;
+  bool escaped = false;
+  bool dropping = false;
+  int i = 0;
+  int field = 0; // where the current top-level field starts in buf
+  int ch;
 
-  if (bufferPos == kBufferSize || (lastRead > 0 && bufferPos == lastRead)) {
-    for (int i = 0; i < timeout && !client->available(); ++i) {
-        delay(1);
+  memset(buf, 0, bufSize);
+  truncated = false;
+  while ((ch = readChunkedData(kQueryTimeout)) >= 0) {
+    if (inString) {
+      if (escaped)
+        escaped = false;
+      else if (ch == '\\')
+        escaped = true;
+      else if (ch == '\"')
+        inString = false;
+    } else if (overflow) {
+      if (ch == '\"')
+        inString = true;
+      else if (ch == '{' || ch == '[')
+        ++overflow;
+      else if (ch == '}' || ch == ']')
+        --overflow;
+      continue;
+    } else if (ch == '{' || ch == '[') {
+      if (depth == PARSE_JSON_MAX_DEPTH) {
+        overflow = 1;
+        dropField(i, field);
+        dropping = true;
+        continue;
+      }
+      nesting[depth++] = (ch == '{') ? '}' : ']';
+    } else if (ch == '}' || ch == ']') {
+      // A close bracket before any value ends the array being iterated.
+      if (!depth || nesting[--depth] != ch)
+        break;
+      if (!depth) {
+        append(i, ch);
+        return true;
+      }
+    } else if (!depth) {
+      continue; // separators between values
+    } else if (ch == '\"') {
+      inString = true;
+    } else if (ch == ',' && depth == 1) {
+      dropping = false;
+      if (!i || buf[i - 1] == '{')
+        continue; // the first field was dropped
+      field = i;
     }
-
-    if (responseLength <= 0) {
-      readLine(snum, sizeof(snum));
-      readLine(snum, sizeof(snum));
-      char *tmp;
-#ifdef DEBUG_RESPONSE
-      Serial.println("");
-      Serial.print("Next chunk:");
-      Serial.println(snum);
-#endif
-      responseLength = strtol(snum, &tmp, 16); 
-      if (!responseLength)
-        return -1;
+    if (dropping)
+      continue;
+    // Leave room for the closing bracket.
+    if (i >= bufSize - 2 && !growBody(i)) {
+      dropField(i, field);
+      dropping = true;
+      continue;
     }
-    if (client->available()) {
-      int to_read = responseLength > kBufferSize ? kBufferSize : responseLength;
-      bufferPos = 0;
-      int sz = client->read((uint8_t *)chunkedBuffer, to_read);
-      lastRead = sz;
+    buf[i++] = ch;
+    if (i == 1)
+      field = i;
+  }
 #ifdef DEBUG_RESPONSE
-      Serial.println();
-      Serial.print("Read: ");
-      Serial.println(sz);
-      Serial.println();
-      Serial.print("bufferPos: ");
-      Serial.println(bufferPos);
-      Serial.println();
-      Serial.print("to_read: ");
-      Serial.println(to_read);
-      Serial.println();
-      Serial.print("responseLength: ");
-      Serial.println(responseLength);
-      printData(chunkedBuffer, sz, bufferPos);
+  Serial.print("Failed");
+  Serial.println(buf);
 #endif
-      if (sz <= 0)
-        return -1;
-      responseLength -= sz;
+  return false;
+}
+
+void ParseResponse::dropField(int& length, int start) {
+  memset(buf + start, 0, length - start);
+  length = start;
+  truncated = true;
+}
+
+int ParseResponse::readChunkedData(int timeout) {
+  // The next byte of the body, taken through the same decoder as
+  // readAvailable() so that chunk framing is handled wherever it falls.
+  unsigned long start = millis();
+  while (readState != READ_DONE) {
+    int c = readInput();
+    if (c >= 0) {
+      if (decode(c))
+        return c;
+    } else if (!client->connected()) {
+      finishRead(readState == READ_BODY && responseLength < 0);
+    } else if (millis() - start > (unsigned long)timeout) {
+      return -1;
+    } else {
+      delay(1);
     }
   }
-  int ch = chunkedBuffer[bufferPos++];
-  return ch;
+  return -1;
 }
 
 int ParseResponse::getErrorCode() {
-  return getInt("code");
+  // Only a failed request has a code in its body, so a 2xx status line is
+  // enough to tell success without reading the body. The results of a batch
+  // carry their own errors, see nextObject().
+  if (queued)
+    return ERROR_QUEUED;
+  if (!isBatch && readHeaders() && http.status >= 200 && http.status < 300)
+    return 0;
+  int code = getInt("code");
+  if (code || isBatch)
+    return code;
+  // The body was not buffered, see want() and writeTo(), or it has no
+  // code. The status line still tells that the request failed.
+  if (!http.status)
+    return ERROR_CONNECTION_FAILED;
+  return http.status >= 400 ? http.status : 0;
 }
 
 const char* ParseResponse::getJSONBody() {
   read();
-  return buf;
+  // No body was buffered when the response ended in its headers, or when
+  // want() or writeTo() consumed it. It then reads as empty.
+  return buf ? buf : noBody;
 }
 
-const char* ParseResponse::getString(const char* key) {
+void ParseResponse::buildIndex() {
   read();
+  // Index the body on the first lookup, later ones are answered from the index.
+  if (!jsonIndex.isBuilt())
+    jsonIndex.build(buf ? buf : noBody);
+}
+
+ParseStringView ParseResponse::getStringView(const char* key) {
+  buildIndex();
+  const char* value;
+  int length;
+  if (!key || !jsonIndex.find(key, &value, &length))
+    return ParseStringView();
+  return ParseStringView(value, length);
+}
+
+const char* ParseResponse::getString(const char* key) {
   if (!tmpBuf) {
-    tmpBuf = new char[64];
+    tmpBuf = allocate(TMPBUFSIZE);
+    if (!tmpBuf)
+      return "";
   }
-  memset(tmpBuf, 0, 64);
-  ParseUtils::getStringFromJSON(buf, key, tmpBuf, 64);
+  memset(tmpBuf, 0, TMPBUFSIZE);
+  buildIndex();
+  jsonIndex.getStringValue(key, tmpBuf, TMPBUFSIZE);
   return tmpBuf;
 }
 
 int ParseResponse::getInt(const char* key) {
-  read();
-  return ParseUtils::getIntFromJSON(buf, key);
+  buildIndex();
+  return ParseUtils::parseLong(jsonIndex.findValue(key));
+}
+
+long long ParseResponse::getLong(const char* key) {
+  buildIndex();
+  return ParseUtils::parseLong(jsonIndex.findValue(key));
 }
 
 double ParseResponse::getDouble(const char* key) {
-  read();
-  return ParseUtils::getFloatFromJSON(buf, key);
+  buildIndex();
+  return ParseUtils::parseDouble(jsonIndex.findValue(key));
 }
 
 bool ParseResponse::getBoolean(const char* key) {
-  read();
-  return ParseUtils::getBooleanFromJSON(buf, key);
+  buildIndex();
+  return ParseUtils::parseBoolean(jsonIndex.findValue(key));
 }
 
 void ParseResponse::readWithTimeout(int maxSec) {
@@ -329,6 +700,7 @@ void ParseResponse::readWithTimeout(int maxSec) {
 }
 
 bool ParseResponse::nextObject() {
+  jsonIndex.clear();
   if(resultCount <= 0) {
     count();
   }
@@ -337,70 +709,176 @@ bool ParseResponse::nextObject() {
     return false;
   }
 
+  bool found;
   if (firstObject) {
     firstObject = false;
-    return true;
+    found = true;
   } else {
-    return readJson(buf, bufSize);
+    if (!buf)
+      allocateBody(); // the result was started by feedNextObject()
+    found = readJson();
+  }
+  if (found && isBatch)
+    unwrapBatchResult();
+  return found;
+}
+
+bool ParseResponse::nextFields(const ParseJsonExtractor::Field* fields, int fieldCount, void* object) {
+  extractor.clear();
+  if (!extractor.setFields(fields, fieldCount, object))
+    return false;
+  bool found = feedNextObject();
+  extractor.clear();
+  return found;
+}
+
+bool ParseResponse::addColumn(const char* key, float* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_FLOAT, values, 0);
+}
+
+bool ParseResponse::addColumn(const char* key, double* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_DOUBLE, values, 0);
+}
+
+bool ParseResponse::addColumn(const char* key, int* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_INT, values, 0);
+}
+
+bool ParseResponse::addColumn(const char* key, unsigned* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_UNSIGNED, values, 0);
+}
+
+bool ParseResponse::addColumn(const char* key, long* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_SIGNED_LONG, values, 0);
+}
+
+bool ParseResponse::addColumn(const char* key, unsigned long* values) {
+  return extractor.add(key, ParseJsonExtractor::TYPE_UNSIGNED_LONG, values, 0);
+}
+
+int ParseResponse::readColumns(int maxRows) {
+  int rows = 0;
+  if (extractor.isActive()) {
+    for (; rows < maxRows; ++rows) {
+      extractor.startRow(rows);
+      if (!feedNextObject())
+        break;
+    }
   }
+  extractor.clear();
+  return rows;
+}
+
+bool ParseResponse::feedNextObject() {
+  // Pass the next object of the result to the extractor, without keeping it.
+  jsonIndex.clear();
+  if (resultCount == -1) {
+    // Start the result here rather than in count(), so that the first object
+    // is not read into the buffer, which drops fields that do not fit.
+    long skipped = openResults();
+    if (skipped < 0)
+      return false;
+    long length = feedObject();
+    if (!length) {
+      resultCount = readCount();
+      return false;
+    }
+    estimateCount(skipped, length);
+    return true;
+  }
+
+  if (resultCount <= 0) {
+    return false;
+  }
+
+  if (firstObject) {
+    // count() has already read the first object into buf.
+    firstObject = false;
+    for (const char* c = buf; *c; ++c) {
+      extractor.feed(*c);
+    }
+    return true;
+  }
+  return feedObject() > 0;
+}
+
+long ParseResponse::feedObject() {
+  int c;
+  long length = 0;
+  while ((c = readChunkedData(kQueryTimeout)) >= 0) {
+    if (!length) {
+      if (c == ']')
+        return 0; // end of the results
+      if (c != '{')
+        continue; // separators between objects
+    }
+    ++length;
+    extractor.feed(c);
+    if (extractor.isDone())
+      return length;
+  }
+  return 0;
+}
+
+int ParseResponse::forEachObject(ParseObjectCallback callback) {
+  int n = 0;
+  while (callback && nextObject()) {
+    jsonIndex.build(buf);
+    ParseObjectView object(jsonIndex, buf);
+    ++n;
+    if (!callback(object))
+      break;
+  }
+  return n;
+}
+
+void ParseResponse::unwrapBatchResult() {
+  // {"success":{...}} or {"error":{...}}: keep the inner object only, so that
+  // getErrorCode() and the getters see the result of the request.
+  char* inner = strchr(buf + 1, '{');
+  int len = inner ? strlen(inner) : 0;
+  if (len < 2 || inner[len - 1] != '}')
+    return;
+  memmove(buf, inner, len - 1);
+  buf[len - 1] = 0;
 }
 
 int ParseResponse::count() {
   if (resultCount != -1)
     return resultCount;
-  char buff[128];
 
-  resultCount = 0;
+  long skipped = openResults();
+  if (skipped < 0)
+    return -1;
+  allocateBody();
 
-  bool first_line = true;
-  bool ok = false;
-  bool done = false;
-  char *ptr;
-  long len = 0;
-  while (client->connected() && !done) {
-    delay(1);
-    while (client->available()) {
-      readLine(buff, sizeof(buff));
-      if (first_line) {
-        if (!strcmp(kHttpOK, buff))
-          ok = true;
-        first_line = false;
-      }
-#ifdef DEBUG_RESPONSE
-      Serial.print("H->");
-      Serial.println(buff);
-#endif
-      if (!strcmp(kChunkedEncoding, buff)) {
-        isChunked = true;
-      } else if (!strncmp(kContentLength, buff, sizeof(kContentLength))) {
-        responseLength = strtol(buff + sizeof(kContentLength), &ptr, 10);
-      } else if (!buff[0]) {
-        if (isChunked && client->available()) {
-          readLine(buff, sizeof(buff));
-          responseLength = strtol(buff, &ptr, 16);
+  if (!readJson()) {
 #ifdef DEBUG_RESPONSE
-          Serial.print("First chunk->");
-          Serial.println(buff);
+    Serial.println("no results");
 #endif
-        }
-        done = true;
-        break;
-      }
-    }
+    // No objects, but a ParseQuery::countOnly() query has the exact count.
+    resultCount = readCount();
+    return resultCount;
   }
-  long persistentResponseLength = responseLength; // responseLength is modified by calls to readChunkedData
-#ifdef DEBUG_RESPONSE
-  sprintf(buff, "Ok:%s Length:%d Chunked:%s", ok ? "y" : "n", responseLength, isChunked ? "y" : "n");
-  Serial.println(buff);
-#endif
-  done = false;
+
+  firstObject = true;
+  estimateCount(skipped, strlen(buf));
+  return resultCount;
+}
+
+long ParseResponse::openResults() {
+  resultCount = 0;
+
+  readHeaders();
   freeBuffer();
-  setBuffer(new char[kJsonResponseMaxSize], kJsonResponseMaxSize);
   dataDone = true;
 
-  for (int i = 0; i < sizeof(kResultsStart) - 1; ++i) {
-    char c = readChunkedData(kQueryTimeout);
-    if (c != kResultsStart[i]) {
+  // Skip to the array of results: {"results":[ for a query, [ for a batch.
+  int c;
+  long skipped = 0;
+  while ((c = readChunkedData(kQueryTimeout)) != '[') {
+    ++skipped;
+    if (c < 0) {
 #ifdef DEBUG_RESPONSE
       Serial.println("Malformed response!");
 #endif
@@ -408,39 +886,70 @@ int ParseResponse::count() {
       return -1;
     }
   }
+  return skipped;
+}
 
-  if (!readJson(buf, bufSize)) {
-#ifdef DEBUG_RESPONSE
-    Serial.println("no results");
-#endif
-    resultCount = 0;
-    return 0;
-  }
-
-  int tmplen = strlen(buf);
-  firstObject = true;
-  if (tmplen > 0)
-    resultCount = persistentResponseLength / tmplen;
-  if (isChunked)
+void ParseResponse::estimateCount(long skipped, long objectLength) {
+  // Estimate from the length of the body, or of its first chunk.
+  long length = http.chunked ? skipped + 1 + objectLength + chunkRemaining : http.contentLength;
+  resultCount = 0;
+  if (objectLength > 0)
+    resultCount = length / objectLength;
+  if (http.chunked)
     resultCount *= 2;
   if (!resultCount)
     resultCount = 1;
+}
 
-  return resultCount;
+int ParseResponse::readCount() {
+  // The number follows the results: {"results":[],"count":42}
+  static const char kCountKey[] = "\"count\":";
+  const char* match = kCountKey;
+  int c;
+  while (*match && (c = readChunkedData(kQueryTimeout)) >= 0) {
+    if (c == *match)
+      ++match;
+    else
+      match = (c == kCountKey[0]) ? kCountKey + 1 : kCountKey;
+  }
+  if (*match)
+    return 0;
+
+  int n = 0;
+  while ((c = readChunkedData(kQueryTimeout)) >= '0' && c <= '9')
+    n = n * 10 + (c - '0');
+  return n;
 }
 
 void ParseResponse::freeBuffer() {
-  if (!isUserBuffer) { // only free non-user buffer
-    delete[] buf;
-    buf = NULL;
+  jsonIndex.clear();
+  if (block) {
+    Parse.bufferPool.give(block);
+    block = NULL;
+    blockUsed = 0;
   }
-  if (tmpBuf) {
-    delete[] tmpBuf;
-    tmpBuf = NULL;
+  if (grown) {
+    if (endpoint && !isUserBuffer)
+      Parse.bufferPool.recordSize(endpoint, bufSize);
+    delete[] grown;
+    grown = NULL;
   }
+  if (!isUserBuffer) // the customer buffer is not ours to free
+    buf = NULL;
+  tmpBuf = NULL;
 }
 
 void ParseResponse::close() {
+  // Consume the rest of an unread response so that a persistent connection
+  // can be handed to the next request.
+  if (client == &Parse.client && Parse.keepAlive && this != &Parse.asyncResponse) {
+    if (!dataDone) {
+      read();
+    } else {
+      // The rest of a query result read through count() and nextObject().
+      while (readChunkedData(kQueryTimeout) >= 0);
+    }
+  }
   freeBuffer();
 }
 